@@ -0,0 +1,326 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AppEvictionManager.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "ApplicationDescription.h"
+#include "CgroupManager.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+#include <glib.h>
+
+// Weights of the eviction score, see evictionScore()
+static const int kPreloadBonus = 1000;
+static const int kKeepAlivePenalty = 500;
+static const int kBackgroundRunPenalty = 300;
+static const int kOverlayPenalty = 100;
+
+AppEvictionManager::AppEvictionManager()
+    : m_discardCount(0)
+    , m_discardedPssSize(0)
+    , m_restoreCount(0)
+    , m_totalRestoreTime(0)
+    , m_comparedRestoreCount(0)
+    , m_comparedRestoreTime(0)
+    , m_comparedLaunchTime(0)
+    , m_level(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+{
+}
+
+void AppEvictionManager::appLaunched(const QString& appId)
+{
+    m_evictionInfoMap[appId].launchTime = g_get_monotonic_time();
+}
+
+void AppEvictionManager::appActivated(const QString& appId)
+{
+    EvictionInfo& info = m_evictionInfoMap[appId];
+    info.lastActivationTime = g_get_monotonic_time();
+
+    if (info.backgroundRunSuspended) {
+        WebAppBase* app = WebAppManager::instance()->findAppById(appId);
+        if (app && app->page())
+            app->page()->setEnableBackgroundRun(true);
+        info.backgroundRunSuspended = false;
+    }
+    info.tier = TierNone;
+}
+
+void AppEvictionManager::appClosed(const QString& appId)
+{
+    m_evictionInfoMap.remove(appId);
+}
+
+void AppEvictionManager::appLaunchFinished(const QString& appId, int launchTime)
+{
+    m_launchTimeMap[appId] = launchTime;
+}
+
+void AppEvictionManager::appRestored(const QString& appId, int restoreTime)
+{
+    m_restoreCount++;
+    m_totalRestoreTime += restoreTime;
+
+    int launchTime = m_launchTimeMap.value(appId, 0);
+    if (launchTime) {
+        m_comparedRestoreCount++;
+        m_comparedRestoreTime += restoreTime;
+        m_comparedLaunchTime += launchTime;
+    }
+
+    LOG_INFO(MSGID_APP_RESTORE, 3, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKFV("RESTORE_MS", "%d", restoreTime),
+        PMLOGKFV("LAUNCH_MS", "%d", launchTime), "");
+}
+
+qint64 AppEvictionManager::lastActivationTime(const QString& appId) const
+{
+    QMap<QString, EvictionInfo>::const_iterator it = m_evictionInfoMap.find(appId);
+    return it == m_evictionInfoMap.end() ? 0 : it.value().lastActivationTime;
+}
+
+bool AppEvictionManager::isCandidate(WebAppBase* app) const
+{
+    if (!app->page() || app->isClosing())
+        return false;
+
+    // Visible windows include apps under an overlay or popup and launches not yet shown
+    if (!app->getHiddenWindow() && (app->isActivated() || !app->isMinimized()))
+        return false;
+
+    if (app == WebAppManager::instance()->getContainerApp())
+        return false;
+
+    if (app->getAppDescription()->defaultWindowType() == "system_ui")
+        return false;
+
+    return true;
+}
+
+uint32_t AppEvictionManager::appPssSize(WebAppBase* app) const
+{
+    uint32_t pid = app->page()->getWebProcessPID();
+    if (!pid)
+        return 0;
+
+    // A shared renderer is split evenly between the apps it hosts
+    size_t apps = std::max(WebAppManager::instance()->runningApps(pid).size(), static_cast<size_t>(1));
+    return WebAppManagerUtils::getProcessPss(pid, WebAppManager::instance()->config()->getProcRoot().toStdString()) / apps;
+}
+
+int AppEvictionManager::evictionScore(WebAppBase* app, uint32_t pssSize) const
+{
+    // One point per minute in background and per 16MB of PSS
+    // Apps never activated are idle since they were launched
+    qint64 since = lastActivationTime(app->appId());
+    if (!since)
+        since = m_evictionInfoMap.value(app->appId()).launchTime;
+    qint64 idle = since ? g_get_monotonic_time() - since : 0;
+    int score = static_cast<int>(idle / (60 * G_USEC_PER_SEC)) + static_cast<int>(pssSize / (16 * 1024));
+
+    // Preloaded apps were never seen by the user
+    if (app->preloadState() != WebAppBase::NONE_PRELOAD)
+        score += kPreloadBonus;
+    if (app->keepAlive())
+        score -= kKeepAlivePenalty;
+    if (app->getAppDescription()->isEnableBackgroundRun())
+        score -= kBackgroundRunPenalty;
+    if (app->getAppDescription()->defaultWindowType() == "overlay")
+        score -= kOverlayPenalty;
+
+    return score;
+}
+
+std::vector<AppEvictionManager::Candidate> AppEvictionManager::rankedCandidates()
+{
+    std::vector<Candidate> candidates;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (!app || !isCandidate(app))
+            continue;
+
+        uint32_t pssSize = appPssSize(app);
+        candidates.push_back(Candidate(app, pssSize, evictionScore(app, pssSize)));
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.score > b.score;
+    });
+    return candidates;
+}
+
+QJsonObject AppEvictionManager::getReclaimCandidates()
+{
+    std::vector<Candidate> candidates = rankedCandidates();
+
+    // The spare container is never evicted by WAM but it is a reclaimable
+    // unit for memorymanager, which can ask to clear it
+    WebAppBase* container = WebAppManager::instance()->getContainerApp();
+    if (container && container->page() && !container->isClosing()) {
+        uint32_t pssSize = appPssSize(container);
+        candidates.push_back(Candidate(container, pssSize, evictionScore(container, pssSize)));
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.score > b.score;
+        });
+    }
+
+    QJsonObject result;
+    QJsonArray units;
+    uint32_t totalPssSize = 0;
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        WebAppBase* app = it->app;
+        QJsonObject unit;
+        if (app == container)
+            unit["type"] = QStringLiteral("container");
+        else if (app->preloadState() != WebAppBase::NONE_PRELOAD)
+            unit["type"] = QStringLiteral("preload");
+        else
+            unit["type"] = QStringLiteral("app");
+        unit["id"] = app->appId();
+        unit["instanceId"] = app->instanceId();
+        unit["pid"] = static_cast<int>(app->page()->getWebProcessPID());
+        unit["pssInKB"] = static_cast<int>(it->pssSize);
+        unit["score"] = it->score;
+        unit["keepAlive"] = app->keepAlive();
+        unit["evicted"] = QLatin1String(tierName(m_evictionInfoMap.value(app->appId()).tier));
+
+        // Restore cost is unknown until a launch of the app has been measured
+        QMap<QString, int>::const_iterator launchTime = m_launchTimeMap.find(app->appId());
+        if (launchTime != m_launchTimeMap.end())
+            unit["restoreCostInMs"] = launchTime.value();
+
+        units.append(unit);
+        totalPssSize += it->pssSize;
+    }
+
+    result["candidates"] = units;
+    result["totalPssInKB"] = static_cast<int>(totalPssSize);
+
+    QJsonObject discardStats;
+    discardStats["discardCount"] = static_cast<int>(m_discardCount);
+    discardStats["discardedPssInKB"] = static_cast<double>(m_discardedPssSize);
+    discardStats["restoreCount"] = static_cast<int>(m_restoreCount);
+    if (m_restoreCount)
+        discardStats["avgRestoreInMs"] = static_cast<int>(m_totalRestoreTime / m_restoreCount);
+    if (m_comparedRestoreCount) {
+        // Same apps only, so both averages describe the same workload
+        discardStats["comparedRestoreInMs"] = static_cast<int>(m_comparedRestoreTime / m_comparedRestoreCount);
+        discardStats["comparedLaunchInMs"] = static_cast<int>(m_comparedLaunchTime / m_comparedRestoreCount);
+    }
+    result["discardStats"] = discardStats;
+    return result;
+}
+
+const char* AppEvictionManager::tierName(EvictionTier tier)
+{
+    switch (tier) {
+    case TierTrim:
+        return "trim";
+    case TierSuspend:
+        return "suspend";
+    case TierDiscard:
+        return "discard";
+    case TierClose:
+        return "close";
+    default:
+        return "none";
+    }
+}
+
+bool AppEvictionManager::evict(const Candidate& candidate, EvictionTier tier)
+{
+    WebAppBase* app = candidate.app;
+    WebPageBase* page = app->page();
+    EvictionInfo& info = m_evictionInfoMap[app->appId()];
+
+    switch (tier) {
+    case TierTrim:
+        page->notifyMemoryPressure(m_level);
+        break;
+    case TierSuspend:
+        if (page->isEnableBackgroundRun()) {
+            page->setEnableBackgroundRun(false);
+            info.backgroundRunSuspended = true;
+        }
+        page->suspendWebPageAll();
+        break;
+    case TierDiscard:
+        // A frozen renderer could not tear the page down
+        WebAppManager::instance()->getCgroupManager()->thawWebProcess(page->getWebProcessPID());
+        if (!app->discard())
+            return false;
+        m_discardCount++;
+        m_discardedPssSize += candidate.pssSize;
+        break;
+    case TierClose:
+        WebAppManager::instance()->closeApp(app->appId().toStdString());
+        break;
+    default:
+        return false;
+    }
+
+    info.tier = tier;
+    LOG_INFO(MSGID_APP_EVICTION, 4, PMLOGKS("APP_ID", qPrintable(app->appId())),
+        PMLOGKS("ACTION", tierName(tier)),
+        PMLOGKFV("PSS_KB", "%u", candidate.pssSize),
+        PMLOGKFV("SCORE", "%d", candidate.score), "");
+    return true;
+}
+
+void AppEvictionManager::memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level)
+{
+    // memorymanager repeats the current level on every threshold change,
+    // so only a level transition may escalate
+    if (level == m_level)
+        return;
+
+    m_level = level;
+    if (level == webos::WebViewBase::MEMORY_PRESSURE_NONE)
+        return;
+
+    if (!WebAppManager::instance()->config()->isAppEvictionEnabled())
+        return;
+
+    // Every transition escalates one step: cheap actions for all
+    // candidates, then at most one discard or close per transition.
+    EvictionTier maxTier = level == webos::WebViewBase::MEMORY_PRESSURE_CRITICAL ? TierClose : TierSuspend;
+    std::vector<Candidate> candidates = rankedCandidates();
+
+    for (int tier = TierTrim; tier <= std::min(maxTier, TierSuspend); tier++) {
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+            if (m_evictionInfoMap[it->app->appId()].tier < tier)
+                evict(*it, static_cast<EvictionTier>(tier));
+        }
+    }
+
+    for (int tier = TierDiscard; tier <= maxTier; tier++) {
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+            if (m_evictionInfoMap[it->app->appId()].tier < tier && evict(*it, static_cast<EvictionTier>(tier)))
+                return;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef APPEVICTIONMANAGER_H
+#define APPEVICTIONMANAGER_H
+
+#include <vector>
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "webos/webview_base.h"
+
+class WebAppBase;
+
+class AppEvictionManager {
+    friend class AppEvictionManagerTest;
+
+public:
+    enum EvictionTier {
+        TierNone = 0,
+        TierTrim,
+        TierSuspend,
+        TierDiscard,
+        TierClose
+    };
+
+    class Candidate {
+    public:
+        Candidate(WebAppBase* a, uint32_t pss, int s)
+            : app(a)
+            , pssSize(pss)
+            , score(s)
+        {
+        }
+
+        WebAppBase* app;
+        uint32_t pssSize; // KB, share of the renderer PSS
+        int score; // higher is evicted first
+    };
+
+    AppEvictionManager();
+    ~AppEvictionManager() {}
+
+    void memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level);
+    void appLaunched(const QString& appId);
+    void appActivated(const QString& appId);
+    void appClosed(const QString& appId);
+    void appLaunchFinished(const QString& appId, int launchTime);
+    void appRestored(const QString& appId, int restoreTime);
+
+    // Background apps ordered from the cheapest to lose
+    std::vector<Candidate> rankedCandidates();
+    qint64 lastActivationTime(const QString& appId) const;
+    QJsonObject getReclaimCandidates();
+
+private:
+    bool isCandidate(WebAppBase* app) const;
+    uint32_t appPssSize(WebAppBase* app) const;
+    int evictionScore(WebAppBase* app, uint32_t pssSize) const;
+    bool evict(const Candidate& candidate, EvictionTier tier);
+    static const char* tierName(EvictionTier tier);
+
+    class EvictionInfo {
+    public:
+        EvictionInfo()
+            : launchTime(0)
+            , lastActivationTime(0)
+            , tier(TierNone)
+            , backgroundRunSuspended(false)
+        {
+        }
+
+        qint64 launchTime; // monotonic usecs
+        qint64 lastActivationTime; // monotonic usecs
+        EvictionTier tier;
+        bool backgroundRunSuspended;
+    };
+    QMap<QString, EvictionInfo> m_evictionInfoMap;
+
+    // First frame time in ms of the last cold launch, kept after the app is closed
+    QMap<QString, int> m_launchTimeMap;
+
+    uint32_t m_discardCount;
+    uint64_t m_discardedPssSize; // KB
+    uint32_t m_restoreCount;
+    uint64_t m_totalRestoreTime; // ms
+    uint32_t m_comparedRestoreCount;
+    uint64_t m_comparedRestoreTime; // ms, restores of apps with a known launch time
+    uint64_t m_comparedLaunchTime; // ms
+
+    webos::WebViewBase::MemoryPressureLevel m_level;
+};
+
+#endif /* APPEVICTIONMANAGER_H */
@@ -55,6 +55,7 @@ ApplicationDescription::ApplicationDescription()
     , m_handleExitKey(false)
     , m_allowVideoCapture(false)
     , m_allowAudioCapture(false)
+    , m_exclusiveForeground(false)
     , m_supportsAudioGuidance(false)
     , m_useNativeScroll(false)
     , m_usePrerendering(false)
@@ -173,6 +174,7 @@ ApplicationDescription* ApplicationDescription::fromJsonString(const char* jsonS
     appDesc->m_enableBackgroundRun = jsonObj["enableBackgroundRun"].toBool();
     appDesc->m_allowVideoCapture = jsonObj["allowVideoCapture"].toBool();
     appDesc->m_allowAudioCapture = jsonObj["allowAudioCapture"].toBool();
+    appDesc->m_exclusiveForeground = jsonObj["exclusiveForeground"].toBool();
     appDesc->m_usePrerendering = jsonObj.contains("usePrerendering") && jsonObj["usePrerendering"].toBool();
     appDesc->m_disallowScrollingInMainFrame = !jsonObj.contains("disallowScrollingInMainFrame") || jsonObj["disallowScrollingInMainFrame"].toBool();
 
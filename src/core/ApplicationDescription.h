@@ -145,6 +145,7 @@ public:
     bool isEnableBackgroundRun() const { return m_enableBackgroundRun; }
     bool allowVideoCapture() const { return m_allowVideoCapture; }
     bool allowAudioCapture() const { return m_allowAudioCapture; }
+    bool isExclusiveForeground() const { return m_exclusiveForeground; }
 
     //Key code is changed only for facebooklogin WebApp
     const QMap<int, QPair<int, int>>& keyFilterTable() const
@@ -220,6 +221,7 @@ private:
     bool m_enableBackgroundRun;
     bool m_allowVideoCapture;
     bool m_allowAudioCapture;
+    bool m_exclusiveForeground;
     bool m_supportsAudioGuidance;
     bool checkTrustLevel(std::string trustLevel);
     bool m_useNativeScroll;
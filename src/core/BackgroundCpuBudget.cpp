@@ -0,0 +1,171 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BackgroundCpuBudget.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "ApplicationDescription.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// Longest throttle in sampling periods, however far over budget the app is
+static const uint32_t kMaxThrottledPeriods = 10;
+
+BackgroundCpuBudget::BackgroundCpuBudget()
+{
+}
+
+void BackgroundCpuBudget::start()
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->hasBackgroundCpuBudget() || m_sampleTimer.isRunning())
+        return;
+
+    m_sampleTimer.start(config->getBackgroundCpuPeriod(), this, &BackgroundCpuBudget::sampleTimeout);
+}
+
+void BackgroundCpuBudget::appClosed(const QString& appId)
+{
+    m_budgetInfoMap.remove(appId);
+}
+
+bool BackgroundCpuBudget::isBudgetedApp(WebAppBase* app) const
+{
+    if (!app->page() || app->isClosing() || !app->page()->isEnableBackgroundRun())
+        return false;
+
+    // Foreground apps run unlimited
+    return !app->isActivated() || app->getHiddenWindow();
+}
+
+void BackgroundCpuBudget::throttle(WebAppBase* app, bool throttled)
+{
+    app->page()->setBackgroundThrottled(WebPageBase::BackgroundThrottleCpuBudget, throttled);
+}
+
+void BackgroundCpuBudget::sampleTimeout()
+{
+    // Background run pages are held by low-power or exclusive mode meanwhile
+    if (WebAppManager::instance()->isLowPowerMode() || WebAppManager::instance()->isExclusiveMode())
+        return;
+
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    qint64 now = g_get_monotonic_time();
+
+    // CPU time is per renderer, apps sharing one are charged all of it
+    QMap<uint32_t, uint32_t> usageMap;
+    QMap<uint32_t, CpuSample> cpuSampleMap;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (!app || !app->page())
+            continue;
+
+        BudgetInfo& info = m_budgetInfoMap[app->appId()];
+        if (!isBudgetedApp(app)) {
+            if (info.remainingPeriods) {
+                info.remainingPeriods = 0;
+                throttle(app, false);
+            }
+            continue;
+        }
+
+        uint32_t pid = app->page()->getWebProcessPID();
+        if (!pid)
+            continue;
+
+        if (!cpuSampleMap.contains(pid)) {
+            CpuSample sample;
+            sample.cpuTime = WebAppManagerUtils::getProcessCpuTime(pid);
+            sample.sampleTime = now;
+            cpuSampleMap[pid] = sample;
+
+            CpuSample last = m_cpuSampleMap.value(pid);
+            if (last.cpuTime >= 0 && sample.cpuTime >= last.cpuTime && now > last.sampleTime)
+                usageMap[pid] = static_cast<uint32_t>((sample.cpuTime - last.cpuTime) * 1000 * 100 / (now - last.sampleTime));
+        }
+
+        // Throttled period is running out, let it run for the next one
+        if (info.remainingPeriods) {
+            info.throttledPeriods++;
+            if (--info.remainingPeriods == 0)
+                throttle(app, false);
+            continue;
+        }
+
+        info.budget = config->getBackgroundCpuBudget(QString::fromStdString(app->getAppDescription()->trustLevel()));
+        if (!info.budget || !usageMap.contains(pid))
+            continue;
+
+        info.usage = usageMap.value(pid);
+        if (info.usage <= info.budget)
+            continue;
+
+        // Stay suspended long enough to bring the average down to the budget
+        info.remainingPeriods = std::min((info.usage + info.budget - 1) / info.budget - 1, kMaxThrottledPeriods);
+        if (!info.remainingPeriods)
+            continue;
+
+        info.violationCount++;
+        throttle(app, true);
+        LOG_INFO(MSGID_BACKGROUND_CPU_BUDGET, 5, PMLOGKS("APP_ID", qPrintable(app->appId())),
+            PMLOGKFV("PID", "%u", pid),
+            PMLOGKFV("USAGE", "%u%%", info.usage),
+            PMLOGKFV("BUDGET", "%u%%", info.budget),
+            PMLOGKFV("PERIODS", "%u", info.remainingPeriods), "Throttle background app");
+    }
+
+    m_cpuSampleMap = cpuSampleMap;
+}
+
+QJsonObject BackgroundCpuBudget::getBackgroundCpuStats() const
+{
+    QJsonObject stats;
+    QJsonArray apps;
+    uint32_t totalViolations = 0;
+    int period = WebAppManager::instance()->config()->getBackgroundCpuPeriod();
+
+    for (QMap<QString, BudgetInfo>::const_iterator it = m_budgetInfoMap.begin(); it != m_budgetInfoMap.end(); ++it) {
+        const BudgetInfo& info = it.value();
+        if (!info.budget)
+            continue;
+
+        QJsonObject app;
+        app["id"] = it.key();
+        app["budgetInPercent"] = static_cast<int>(info.budget);
+        app["lastUsageInPercent"] = static_cast<int>(info.usage);
+        app["violationCount"] = static_cast<int>(info.violationCount);
+        app["throttledTimeInMs"] = static_cast<int>(info.throttledPeriods * period);
+        app["throttled"] = info.remainingPeriods > 0;
+        apps.append(app);
+
+        totalViolations += info.violationCount;
+    }
+
+    stats["apps"] = apps;
+    stats["periodInMs"] = period;
+    stats["totalViolations"] = static_cast<int>(totalViolations);
+    return stats;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BACKGROUNDCPUBUDGET_H
+#define BACKGROUNDCPUBUDGET_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Limits the CPU used by hidden apps with enableBackgroundRun, which are
+// never suspended, by suspending their DOM for whole sampling periods
+class BackgroundCpuBudget {
+public:
+    BackgroundCpuBudget();
+    ~BackgroundCpuBudget() {}
+
+    void start();
+    void appClosed(const QString& appId);
+    QJsonObject getBackgroundCpuStats() const;
+
+private:
+    void sampleTimeout();
+    bool isBudgetedApp(WebAppBase* app) const;
+    void throttle(WebAppBase* app, bool throttled);
+
+    class CpuSample {
+    public:
+        CpuSample()
+            : cpuTime(-1)
+            , sampleTime(0)
+        {
+        }
+
+        long cpuTime; // ms
+        qint64 sampleTime; // monotonic usecs
+    };
+    QMap<uint32_t, CpuSample> m_cpuSampleMap;
+
+    class BudgetInfo {
+    public:
+        BudgetInfo()
+            : budget(0)
+            , usage(0)
+            , violationCount(0)
+            , throttledPeriods(0)
+            , remainingPeriods(0)
+        {
+        }
+
+        uint32_t budget; // percent of one CPU
+        uint32_t usage; // percent of one CPU over the last period
+        uint32_t violationCount;
+        uint32_t throttledPeriods;
+        uint32_t remainingPeriods; // > 0 while throttled
+    };
+    QMap<QString, BudgetInfo> m_budgetInfoMap;
+
+    RepeatingTimer<BackgroundCpuBudget> m_sampleTimer;
+};
+
+#endif /* BACKGROUNDCPUBUDGET_H */
@@ -0,0 +1,391 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CgroupManager.h"
+
+#include <algorithm>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// cpu.weight ranges from 1 to 10000, 100 is the kernel default
+static const int kCpuWeight[CgroupManager::CgroupCount] = { 20, 100, 1000 };
+
+// Processes moved into this group are frozen, moving them out thaws them
+static const char* const kFrozenCgroup = "frozen";
+
+CgroupManager::CgroupManager()
+    : m_enabled(false)
+    , m_deepSuspendEnabled(false)
+    , m_freezeCount(0)
+    , m_thawCount(0)
+    , m_wakeupsAvoided(0)
+    , m_totalThawLatency(0)
+    , m_maxThawLatency(0)
+{
+}
+
+const char* CgroupManager::cgroupName(CgroupType type)
+{
+    switch (type) {
+    case CgroupPreload:
+        return "preload";
+    case CgroupBackground:
+        return "background";
+    case CgroupForeground:
+        return "foreground";
+    default:
+        return "none";
+    }
+}
+
+QString CgroupManager::cgroupPath(CgroupType type) const
+{
+    return m_root + QLatin1Char('/') + QLatin1String(cgroupName(type));
+}
+
+bool CgroupManager::writeCgroupFile(const QString& path, const QByteArray& value) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(value) != value.size()) {
+        LOG_WARNING(MSGID_CGROUP_WRITE_FAIL, 2, PMLOGKS("PATH", qPrintable(path)), PMLOGKS("VALUE", value.constData()), "");
+        return false;
+    }
+    return true;
+}
+
+void CgroupManager::init()
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    m_root = config->getCgroupRoot();
+    if (m_root.isEmpty())
+        return;
+
+    // cgroup v2 has cgroup.controllers in every group, v1 never does
+    QString parent = QFileInfo(m_root).absolutePath();
+    if (!QFile::exists(parent + QLatin1String("/cgroup.controllers"))) {
+        LOG_INFO(MSGID_CGROUP, 1, PMLOGKS("ROOT", qPrintable(m_root)), "No cgroup v2, renderers are not placed");
+        return;
+    }
+
+    if (!QDir().mkpath(m_root)) {
+        LOG_WARNING(MSGID_CGROUP_WRITE_FAIL, 1, PMLOGKS("PATH", qPrintable(m_root)), "Cannot create cgroup");
+        return;
+    }
+
+    // Controllers may already be delegated, so failures here are not fatal
+    writeCgroupFile(parent + QLatin1String("/cgroup.subtree_control"), "+cpu +memory");
+    writeCgroupFile(m_root + QLatin1String("/cgroup.subtree_control"), "+cpu +memory");
+
+    for (int type = CgroupPreload; type < CgroupCount; type++) {
+        QString path = cgroupPath(static_cast<CgroupType>(type));
+        if (!QDir().mkpath(path)) {
+            LOG_WARNING(MSGID_CGROUP_WRITE_FAIL, 1, PMLOGKS("PATH", qPrintable(path)), "Cannot create cgroup");
+            return;
+        }
+
+        writeCgroupFile(path + QLatin1String("/cpu.weight"), QByteArray::number(kCpuWeight[type]));
+
+        uint32_t memoryHigh = config->getCgroupMemoryHigh(QLatin1String(cgroupName(static_cast<CgroupType>(type))));
+        writeCgroupFile(path + QLatin1String("/memory.high"),
+            memoryHigh ? QByteArray::number(static_cast<qulonglong>(memoryHigh) * 1024 * 1024) : QByteArray("max"));
+    }
+
+    m_enabled = true;
+    LOG_INFO(MSGID_CGROUP, 1, PMLOGKS("ROOT", qPrintable(m_root)), "Renderers are placed by app state");
+
+    initFrozenCgroup();
+}
+
+void CgroupManager::initFrozenCgroup()
+{
+    uint32_t idleTime = WebAppManager::instance()->config()->getDeepSuspendIdleTime();
+    if (!idleTime)
+        return;
+
+    QString path = m_root + QLatin1Char('/') + QLatin1String(kFrozenCgroup);
+    if (!QDir().mkpath(path) || !writeCgroupFile(path + QLatin1String("/cgroup.freeze"), "1"))
+        return;
+
+    // Check a few times per idle period so renderers freeze close to it
+    m_deepSuspendEnabled = true;
+    m_freezeTimer.start(std::max<uint32_t>(1000, idleTime * 1000 / 4), this, &CgroupManager::freezeTimeout);
+    LOG_INFO(MSGID_DEEP_SUSPEND, 1, PMLOGKFV("IDLE_TIME", "%u", idleTime), "Idle background renderers are frozen");
+}
+
+CgroupManager::CgroupType CgroupManager::cgroupForWebProcess(uint32_t pid) const
+{
+    // A shared renderer follows the most important app it hosts
+    CgroupType type = CgroupNone;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps(pid);
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        const WebAppBase* app = *it;
+        if (m_foregroundAppIds.contains(app->appId()))
+            return CgroupForeground;
+
+        WebAppBase* running = WebAppManager::instance()->findAppById(app->appId());
+        if (running && running->preloadState() != WebAppBase::NONE_PRELOAD)
+            type = std::max(type, CgroupPreload);
+        else
+            type = std::max(type, CgroupBackground);
+    }
+
+    // The spare container waits like a preloaded app
+    WebAppBase* container = WebAppManager::instance()->getContainerApp();
+    if (type == CgroupNone && container && container->page() && container->page()->getWebProcessPID() == pid)
+        type = CgroupPreload;
+
+    return type;
+}
+
+void CgroupManager::placeWebProcess(uint32_t pid)
+{
+    if (!m_enabled || !pid)
+        return;
+
+    // Thawing places the renderer by its current apps as well
+    if (m_idleInfoMap.value(pid).frozen) {
+        thawWebProcess(pid);
+        return;
+    }
+
+    CgroupType type = cgroupForWebProcess(pid);
+    if (type == CgroupNone)
+        return;
+
+    if (m_webProcessCgroupMap.value(pid, CgroupNone) != type) {
+        if (!writeCgroupFile(cgroupPath(type) + QLatin1String("/cgroup.procs"), QByteArray::number(pid)))
+            return;
+
+        m_webProcessCgroupMap[pid] = type;
+        LOG_INFO(MSGID_CGROUP, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("CGROUP", cgroupName(type)), "");
+    }
+
+    updateIdleInfo(pid, type);
+}
+
+void CgroupManager::updateIdleInfo(uint32_t pid, CgroupType type)
+{
+    if (!m_deepSuspendEnabled)
+        return;
+
+    if (type == CgroupForeground) {
+        m_idleInfoMap.remove(pid);
+        return;
+    }
+
+    // Idle time counts from when the renderer left the foreground
+    if (m_idleInfoMap.contains(pid))
+        return;
+
+    IdleInfo info;
+    info.idleSince = g_get_monotonic_time();
+    info.contextSwitches = WebAppManagerUtils::getProcessContextSwitches(pid);
+    m_idleInfoMap.insert(pid, info);
+}
+
+bool CgroupManager::canFreezeWebProcess(uint32_t pid) const
+{
+    if (m_webProcessCgroupMap.value(pid, CgroupNone) == CgroupForeground)
+        return false;
+
+    // The spare container must answer the next launch right away
+    WebAppBase* container = WebAppManager::instance()->getContainerApp();
+    if (container && container->page() && container->page()->getWebProcessPID() == pid)
+        return false;
+
+    // Only renderers whose apps are all suspended; apps running in the
+    // background keep working while hidden
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps(pid);
+    if (apps.empty())
+        return false;
+
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (!app || !app->page() || m_foregroundAppIds.contains(app->appId()))
+            return false;
+        if (app->page()->isEnableBackgroundRun() || app->page()->isClosing())
+            return false;
+    }
+
+    return true;
+}
+
+void CgroupManager::freezeWebProcess(uint32_t pid)
+{
+    IdleInfo& info = m_idleInfoMap[pid];
+    qint64 now = g_get_monotonic_time();
+
+    // The wakeup rate while idle is what freezing saves from now on
+    long contextSwitches = WebAppManagerUtils::getProcessContextSwitches(pid);
+    if (info.contextSwitches >= 0 && contextSwitches >= info.contextSwitches && now > info.idleSince)
+        info.wakeupRate = (contextSwitches - info.contextSwitches) * 1000000.0 / (now - info.idleSince);
+
+    QString path = m_root + QLatin1Char('/') + QLatin1String(kFrozenCgroup);
+    if (!writeCgroupFile(path + QLatin1String("/cgroup.procs"), QByteArray::number(pid)))
+        return;
+
+    info.frozen = true;
+    info.frozenTime = now;
+    m_freezeCount++;
+    LOG_INFO(MSGID_DEEP_SUSPEND, 2, PMLOGKFV("PID", "%u", pid),
+        PMLOGKFV("WAKEUP_RATE", "%.1f", info.wakeupRate), "Freeze idle renderer");
+}
+
+void CgroupManager::thawWebProcess(uint32_t pid)
+{
+    if (!m_idleInfoMap.value(pid).frozen)
+        return;
+
+    CgroupType type = cgroupForWebProcess(pid);
+    if (type == CgroupNone)
+        type = m_webProcessCgroupMap.value(pid, CgroupBackground);
+
+    // Leaving the frozen group thaws the renderer before the write returns
+    qint64 start = g_get_monotonic_time();
+    if (!writeCgroupFile(cgroupPath(type) + QLatin1String("/cgroup.procs"), QByteArray::number(pid)))
+        return;
+    qint64 now = g_get_monotonic_time();
+    qint64 latency = now - start;
+
+    IdleInfo& info = m_idleInfoMap[pid];
+    double wakeupsAvoided = info.wakeupRate * (now - info.frozenTime) / 1000000.0;
+    m_wakeupsAvoided += wakeupsAvoided;
+    m_thawCount++;
+    m_totalThawLatency += latency;
+    m_maxThawLatency = std::max(m_maxThawLatency, latency);
+    m_webProcessCgroupMap[pid] = type;
+
+    LOG_INFO(MSGID_DEEP_SUSPEND, 4, PMLOGKFV("PID", "%u", pid), PMLOGKS("CGROUP", cgroupName(type)),
+        PMLOGKFV("LATENCY", "%lld", static_cast<long long>(latency)),
+        PMLOGKFV("WAKEUPS_AVOIDED", "%.0f", wakeupsAvoided), "Thaw renderer");
+
+    // A foreground renderer is not idle, otherwise idling starts over
+    m_idleInfoMap.remove(pid);
+    updateIdleInfo(pid, type);
+}
+
+void CgroupManager::freezeTimeout()
+{
+    qint64 idleTime = static_cast<qint64>(WebAppManager::instance()->config()->getDeepSuspendIdleTime()) * 1000000;
+    qint64 now = g_get_monotonic_time();
+
+    QList<uint32_t> pids = m_idleInfoMap.keys();
+    for (int i = 0; i < pids.size(); i++) {
+        const IdleInfo& info = m_idleInfoMap[pids.at(i)];
+        if (info.frozen || now - info.idleSince < idleTime)
+            continue;
+
+        if (canFreezeWebProcess(pids.at(i)))
+            freezeWebProcess(pids.at(i));
+    }
+}
+
+QList<uint32_t> CgroupManager::freezeWebProcesses(const QSet<uint32_t>& excludedPids)
+{
+    // Freezes every renderer that could be frozen, without waiting for the idle time
+    QList<uint32_t> frozenPids;
+    if (!m_deepSuspendEnabled)
+        return frozenPids;
+
+    QList<uint32_t> pids = m_webProcessCgroupMap.keys();
+    for (int i = 0; i < pids.size(); i++) {
+        uint32_t pid = pids.at(i);
+        if (excludedPids.contains(pid) || m_idleInfoMap.value(pid).frozen || !canFreezeWebProcess(pid))
+            continue;
+
+        updateIdleInfo(pid, m_webProcessCgroupMap.value(pid));
+        freezeWebProcess(pid);
+        if (m_idleInfoMap.value(pid).frozen)
+            frozenPids.append(pid);
+    }
+    return frozenPids;
+}
+
+QJsonObject CgroupManager::getDeepSuspendStats() const
+{
+    QJsonObject stats;
+    QJsonArray frozenProcesses;
+    qint64 now = g_get_monotonic_time();
+    double wakeupsAvoided = m_wakeupsAvoided;
+
+    for (QMap<uint32_t, IdleInfo>::const_iterator it = m_idleInfoMap.begin(); it != m_idleInfoMap.end(); ++it) {
+        const IdleInfo& info = it.value();
+        if (!info.frozen)
+            continue;
+
+        QJsonObject process;
+        process["pid"] = static_cast<int>(it.key());
+        process["frozenTimeInSec"] = static_cast<int>((now - info.frozenTime) / 1000000);
+        process["wakeupsPerSec"] = info.wakeupRate;
+        frozenProcesses.append(process);
+
+        wakeupsAvoided += info.wakeupRate * (now - info.frozenTime) / 1000000.0;
+    }
+
+    stats["enabled"] = m_deepSuspendEnabled;
+    stats["idleTimeInSec"] = static_cast<int>(WebAppManager::instance()->config()->getDeepSuspendIdleTime());
+    stats["frozenProcesses"] = frozenProcesses;
+    stats["freezeCount"] = static_cast<int>(m_freezeCount);
+    stats["thawCount"] = static_cast<int>(m_thawCount);
+    stats["wakeupsAvoided"] = static_cast<double>(static_cast<qint64>(wakeupsAvoided));
+    stats["averageThawLatencyInUs"] = m_thawCount ? static_cast<double>(m_totalThawLatency / m_thawCount) : 0;
+    stats["maxThawLatencyInUs"] = static_cast<double>(m_maxThawLatency);
+    return stats;
+}
+
+void CgroupManager::appActivated(WebAppBase* app)
+{
+    m_foregroundAppIds.insert(app->appId());
+    if (app->page())
+        placeWebProcess(app->page()->getWebProcessPID());
+}
+
+void CgroupManager::appDeactivated(WebAppBase* app)
+{
+    m_foregroundAppIds.remove(app->appId());
+    if (app->page())
+        placeWebProcess(app->page()->getWebProcessPID());
+}
+
+void CgroupManager::appClosed(const QString& appId, uint32_t pid)
+{
+    m_foregroundAppIds.remove(appId);
+    placeWebProcess(pid);
+}
+
+void CgroupManager::webProcessCreated(uint32_t pid)
+{
+    placeWebProcess(pid);
+}
+
+void CgroupManager::webProcessExited(uint32_t pid)
+{
+    // The kernel drops the pid from its cgroup
+    m_webProcessCgroupMap.remove(pid);
+    m_idleInfoMap.remove(pid);
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CGROUPMANAGER_H
+#define CGROUPMANAGER_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Places renderers into foreground, background and preload cgroups under
+// WAM_CGROUP_ROOT. Does nothing when the root is not on cgroup v2.
+// Renderers left idle in the background for WAM_DEEP_SUSPEND_IDLE_IN_SEC are
+// moved into a frozen group until one of their apps is brought back.
+class CgroupManager {
+public:
+    enum CgroupType {
+        CgroupNone = -1,
+        CgroupPreload = 0,
+        CgroupBackground,
+        CgroupForeground,
+        CgroupCount
+    };
+
+    CgroupManager();
+    ~CgroupManager() {}
+
+    void init();
+    bool isEnabled() const { return m_enabled; }
+
+    void appActivated(WebAppBase* app);
+    void appDeactivated(WebAppBase* app);
+    void appClosed(const QString& appId, uint32_t pid);
+    void webProcessCreated(uint32_t pid);
+    void webProcessExited(uint32_t pid);
+    void thawWebProcess(uint32_t pid);
+    QList<uint32_t> freezeWebProcesses(const QSet<uint32_t>& excludedPids);
+    QJsonObject getDeepSuspendStats() const;
+
+private:
+    CgroupType cgroupForWebProcess(uint32_t pid) const;
+    void placeWebProcess(uint32_t pid);
+    bool writeCgroupFile(const QString& path, const QByteArray& value) const;
+    QString cgroupPath(CgroupType type) const;
+    static const char* cgroupName(CgroupType type);
+
+    void initFrozenCgroup();
+    void updateIdleInfo(uint32_t pid, CgroupType type);
+    bool canFreezeWebProcess(uint32_t pid) const;
+    void freezeWebProcess(uint32_t pid);
+    void freezeTimeout();
+
+    bool m_enabled;
+    QString m_root;
+    QSet<QString> m_foregroundAppIds;
+    QMap<uint32_t, CgroupType> m_webProcessCgroupMap;
+
+    class IdleInfo {
+    public:
+        IdleInfo()
+            : idleSince(0)
+            , contextSwitches(-1)
+            , wakeupRate(0)
+            , frozenTime(0)
+            , frozen(false)
+        {
+        }
+
+        qint64 idleSince; // monotonic usecs
+        long contextSwitches; // sampled at idleSince
+        double wakeupRate; // per second while idle, before freezing
+        qint64 frozenTime; // monotonic usecs
+        bool frozen;
+    };
+    QMap<uint32_t, IdleInfo> m_idleInfoMap;
+
+    bool m_deepSuspendEnabled;
+    uint32_t m_freezeCount;
+    uint32_t m_thawCount;
+    double m_wakeupsAvoided;
+    qint64 m_totalThawLatency; // usecs
+    qint64 m_maxThawLatency; // usecs
+    RepeatingTimer<CgroupManager> m_freezeTimer;
+};
+
+#endif /* CGROUPMANAGER_H */
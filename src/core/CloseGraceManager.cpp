@@ -0,0 +1,172 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CloseGraceManager.h"
+
+#include <algorithm>
+
+#include <QStringList>
+
+#include "ApplicationDescription.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+CloseGraceManager::CloseGraceManager()
+    : m_level(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_deferredCount(0)
+    , m_reopenedCount(0)
+{
+}
+
+bool CloseGraceManager::deferClose(WebAppBase* app)
+{
+    uint32_t gracePeriod = WebAppManager::instance()->config()->getCloseGracePeriod();
+    if (!gracePeriod || !app->page() || app->isClosing())
+        return false;
+
+    // Closes requested to free memory must not be deferred
+    if (m_level != webos::WebViewBase::MEMORY_PRESSURE_NONE)
+        return false;
+
+    // keepAlive apps are hidden on close anyway, and preloaded, crashed or
+    // discarded apps have no warm page worth keeping
+    if (app->keepAlive() || app->preloadState() != WebAppBase::NONE_PRELOAD
+        || app->getCrashState() || app->isDiscarded())
+        return false;
+
+    if (app == WebAppManager::instance()->getContainerApp())
+        return false;
+
+    if (m_graceInfoMap.contains(app->appId()))
+        return false;
+
+    app->page()->closeVkb();
+    app->hide(true);
+    app->deleteSurfaceGroup();
+    app->onStageDeactivated();
+
+    GraceInfo& info = m_graceInfoMap[app->appId()];
+    info.app = app;
+    info.expireTime = g_get_monotonic_time() + static_cast<qint64>(gracePeriod) * G_USEC_PER_SEC;
+    m_deferredCount++;
+
+    LOG_INFO(MSGID_CLOSE_GRACE, 3, PMLOGKS("APP_ID", qPrintable(app->appId())),
+        PMLOGKFV("PID", "%d", app->page()->getWebProcessPID()),
+        PMLOGKFV("GRACE_SEC", "%u", gracePeriod), "Hide and suspend instead of close");
+
+    scheduleExpiry();
+    return true;
+}
+
+WebAppBase* CloseGraceManager::takeApp(const QString& appId)
+{
+    QMap<QString, GraceInfo>::iterator it = m_graceInfoMap.find(appId);
+    if (it == m_graceInfoMap.end())
+        return 0;
+
+    WebAppBase* app = it.value().app;
+    m_graceInfoMap.erase(it);
+    m_reopenedCount++;
+
+    LOG_INFO(MSGID_CLOSE_GRACE, 3, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKFV("COLD_LAUNCH_AVOIDED", "%u", m_reopenedCount),
+        PMLOGKFV("DEFERRED_CLOSE", "%u", m_deferredCount), "Reopened within grace period");
+
+    scheduleExpiry();
+    return app;
+}
+
+void CloseGraceManager::finishClose(const QString& appId)
+{
+    WebAppBase* app = m_graceInfoMap.take(appId).app;
+    if (!app)
+        return;
+
+    LOG_INFO(MSGID_CLOSE_GRACE, 1, PMLOGKS("APP_ID", qPrintable(appId)), "Finish close");
+    WebAppManager::instance()->closeAppInternal(app);
+}
+
+bool CloseGraceManager::appCrashed(const QString& appId)
+{
+    // The page is about to be deleted with its renderer, nothing warm is left
+    WebAppBase* app = m_graceInfoMap.take(appId).app;
+    if (!app)
+        return false;
+
+    LOG_INFO(MSGID_CLOSE_GRACE, 1, PMLOGKS("APP_ID", qPrintable(appId)), "Renderer crashed, finish close");
+    scheduleExpiry();
+    WebAppManager::instance()->closeAppInternal(app, true);
+    return true;
+}
+
+void CloseGraceManager::finishAll(uint32_t pid)
+{
+    QStringList appIds;
+    for (QMap<QString, GraceInfo>::const_iterator it = m_graceInfoMap.begin(); it != m_graceInfoMap.end(); ++it) {
+        if (!pid || it.value().app->page()->getWebProcessPID() == pid)
+            appIds.append(it.key());
+    }
+
+    for (int i = 0; i < appIds.size(); i++)
+        finishClose(appIds.at(i));
+
+    scheduleExpiry();
+}
+
+void CloseGraceManager::memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level)
+{
+    m_level = level;
+
+    // Warm pages are the first thing to give back
+    if (level != webos::WebViewBase::MEMORY_PRESSURE_NONE)
+        finishAll();
+}
+
+void CloseGraceManager::scheduleExpiry()
+{
+    if (m_expiryTimer.isRunning())
+        m_expiryTimer.stop();
+
+    if (m_graceInfoMap.isEmpty())
+        return;
+
+    qint64 expireTime = G_MAXINT64;
+    for (QMap<QString, GraceInfo>::const_iterator it = m_graceInfoMap.begin(); it != m_graceInfoMap.end(); ++it)
+        expireTime = std::min(expireTime, it.value().expireTime);
+
+    qint64 delay = std::max(expireTime - g_get_monotonic_time(), static_cast<qint64>(0)) / 1000;
+    m_expiryTimer.start(static_cast<int>(delay), this, &CloseGraceManager::expiryTimeout);
+}
+
+void CloseGraceManager::expiryTimeout()
+{
+    qint64 now = g_get_monotonic_time();
+    QStringList appIds;
+    for (QMap<QString, GraceInfo>::const_iterator it = m_graceInfoMap.begin(); it != m_graceInfoMap.end(); ++it) {
+        if (it.value().expireTime <= now)
+            appIds.append(it.key());
+    }
+
+    for (int i = 0; i < appIds.size(); i++)
+        finishClose(appIds.at(i));
+
+    scheduleExpiry();
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CLOSEGRACEMANAGER_H
+#define CLOSEGRACEMANAGER_H
+
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+#include "webos/webview_base.h"
+
+class WebAppBase;
+
+// Keeps closed apps hidden and suspended for a while, so that an app
+// reopened right after being closed is relaunched instead of cold launched
+class CloseGraceManager {
+public:
+    CloseGraceManager();
+    ~CloseGraceManager() {}
+
+    // Returns false when the app should be closed right away
+    bool deferClose(WebAppBase* app);
+    // Returns the app held for appId and stops holding it, or 0
+    WebAppBase* takeApp(const QString& appId);
+    // Closes an app held for appId whose renderer crashed, false when none is held
+    bool appCrashed(const QString& appId);
+    void finishAll(uint32_t pid = 0);
+    void memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level);
+
+private:
+    void finishClose(const QString& appId);
+    void scheduleExpiry();
+    void expiryTimeout();
+
+    class GraceInfo {
+    public:
+        GraceInfo()
+            : app(0)
+            , expireTime(0)
+        {
+        }
+
+        WebAppBase* app;
+        qint64 expireTime; // monotonic usecs
+    };
+    QMap<QString, GraceInfo> m_graceInfoMap;
+
+    OneShotTimer<CloseGraceManager> m_expiryTimer;
+
+    webos::WebViewBase::MemoryPressureLevel m_level;
+    uint32_t m_deferredCount;
+    uint32_t m_reopenedCount; // cold launches avoided
+};
+
+#endif /* CLOSEGRACEMANAGER_H */
@@ -20,6 +20,7 @@
 #include <QtCore/QJsonDocument>
 
 #include "ApplicationDescription.h"
+#include "LaunchScheduler.h"
 #include "LogManager.h"
 #include "WebAppBase.h"
 #include "WebAppFactoryManager.h"
@@ -28,6 +29,8 @@
 #include "WebPageBase.h"
 #include "WindowTypes.h"
 
+#include <glib.h>
+
 static QString s_containerAppId = "com.webos.app.container";
 static int kContainerAppLaunchDuration = 300;
 static int kContainerAppLaunchCpuThresh = 500; // 100 = 10%
@@ -49,6 +52,9 @@ ContainerAppManager::ContainerAppManager()
     , m_containerAppIsReady(false)
     , m_launchContainerAppOnDemand(false)
     , m_useContainerAppOptimization(false)
+    , m_warmupYieldTime(0)
+    , m_warmupPauseCount(0)
+    , m_warmupPending(false)
 {
 #ifndef PRELOADMANAGER_ENABLED
     loadContainerInfo();
@@ -87,6 +93,11 @@ void ContainerAppManager::loadContainerInfo()
 void ContainerAppManager::startContainerTimer()
 {
     m_containerAppLaunchTimer.stop();
+    if (m_warmupPauseCount) {
+        m_warmupPending = true;
+        return;
+    }
+
     WebAppManagerUtils::updateAndGetCpuIdle(true);
     m_containerAppLaunchTimer.start(kContainerAppLaunchDuration, this,
                                     &ContainerAppManager::containerAppLaunch);
@@ -102,10 +113,42 @@ QString& ContainerAppManager::getContainerAppId()
     return s_containerAppId;
 }
 
+void ContainerAppManager::pauseWarmup()
+{
+    m_warmupPauseCount++;
+    if (m_containerAppLaunchTimer.isRunning()) {
+        m_containerAppLaunchTimer.stop();
+        m_warmupPending = true;
+    }
+}
+
+void ContainerAppManager::resumeWarmup()
+{
+    if (!m_warmupPauseCount || --m_warmupPauseCount)
+        return;
+
+    if (m_warmupPending) {
+        m_warmupPending = false;
+        startContainerTimer();
+    }
+}
+
 void ContainerAppManager::containerAppLaunch()
 {
+    // Warming up the container yields to launches of every other class
+    LaunchScheduler* scheduler = WebAppManager::instance()->getLaunchScheduler();
+    if (scheduler->shouldYield(LaunchScheduler::ClassWarmup)) {
+        if (!m_warmupYieldTime)
+            m_warmupYieldTime = g_get_monotonic_time();
+        m_containerAppLaunchTimer.start(LaunchScheduler::kYieldIntervalMs, this,
+                                        &ContainerAppManager::containerAppLaunch);
+        return;
+    }
+
     if (++m_containerAppRelaunchCounter >= kContainerAppLaunchTryMax || WebAppManagerUtils::updateAndGetCpuIdle() > kContainerAppLaunchCpuThresh) {
         m_containerAppRelaunchCounter = 0;
+        scheduler->recordQueueDelay(LaunchScheduler::ClassWarmup, m_warmupYieldTime ? g_get_monotonic_time() - m_warmupYieldTime : 0);
+        m_warmupYieldTime = 0;
         int errorCode;
         if (!m_containerApp) {
             std::string instanceId = WebAppManager::instance()->generateInstanceId();
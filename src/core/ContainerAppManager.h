@@ -31,6 +31,9 @@ public:
 
     void startContainerTimer();
     void stopContainerTimer();
+    // Nested, a warmup due meanwhile starts once every pause is resumed
+    void pauseWarmup();
+    void resumeWarmup();
     QString& getContainerAppId();
     WebAppBase* launchContainerApp(const std::string& appDesc, const std::string& instanceId, int& errorCode);
     void closeContainerApp();
@@ -61,6 +64,9 @@ private:
     bool m_containerAppIsReady;
     bool m_launchContainerAppOnDemand;
     bool m_useContainerAppOptimization;
+    qint64 m_warmupYieldTime; // monotonic usecs, 0 when warmup did not yield
+    int m_warmupPauseCount; // pauseWarmup() calls not resumed yet
+    bool m_warmupPending; // a warmup was due while paused
 };
 
 #endif /* CONTAINERAPPMANAGER_H */
@@ -0,0 +1,191 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CrashRecoveryManager.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "LaunchScheduler.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+CrashRecoveryManager::CrashRecoveryManager()
+{
+}
+
+bool CrashRecoveryManager::appCrashed(WebAppBase* app)
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    CrashRecoveryInfo& info = m_crashRecoveryInfoMap[app->appId()];
+    qint64 now = g_get_monotonic_time();
+
+    // Crashes spread further apart than the stable period are not a crash loop
+    qint64 stablePeriod = static_cast<qint64>(config->getCrashRecoveryStablePeriod()) * G_USEC_PER_SEC;
+    if (info.lastCrashTime && now - info.lastCrashTime < stablePeriod)
+        info.consecutiveCrashes++;
+    else
+        info.consecutiveCrashes = 1;
+    info.lastCrashTime = now;
+    info.crashCount++;
+
+    if (!app->isActivated() || app->getHiddenWindow()) {
+        // Background apps are reloaded when they are shown again
+        LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKS("InBackground", "Will be Reloaded in Relaunch"), "");
+        info.recoveryTime = 0;
+        info.deferredCount++;
+        app->setCrashState(true);
+        return true;
+    }
+
+    uint32_t limit = config->getCrashRecoveryLimit();
+    if (app->isNormal() && limit > 1)
+        limit--;
+
+    if (info.consecutiveCrashes >= limit) {
+        LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKS("InForeground", "true"), PMLOGKFV("CONSECUTIVE_CRASHES", "%u", info.consecutiveCrashes), "Reloading limit; Close app");
+        info.recoveryTime = 0;
+        info.giveUpCount++;
+        return false;
+    }
+
+    int delay = nextRecoveryDelay(info.consecutiveCrashes);
+    info.recoveryTime = now + static_cast<qint64>(delay) * 1000;
+    LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKS("InForeground", "true"), PMLOGKFV("RELOAD_DELAY_MS", "%d", delay), "Reload default page");
+
+    scheduleRecovery();
+    return true;
+}
+
+void CrashRecoveryManager::appClosed(const QString& appId)
+{
+    QMap<QString, CrashRecoveryInfo>::iterator it = m_crashRecoveryInfoMap.find(appId);
+    if (it == m_crashRecoveryInfoMap.end() || !it.value().recoveryTime)
+        return;
+
+    it.value().recoveryTime = 0;
+    scheduleRecovery();
+}
+
+int CrashRecoveryManager::nextRecoveryDelay(uint32_t consecutiveCrashes) const
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    qint64 delay = config->getCrashRecoveryBaseDelay();
+    for (uint32_t i = 1; i < consecutiveCrashes && delay < config->getCrashRecoveryMaxDelay(); i++)
+        delay *= 2;
+    delay = std::min(delay, static_cast<qint64>(config->getCrashRecoveryMaxDelay()));
+
+    // Spread reloads of apps sharing the crashed renderer over the upper half of the delay
+    if (delay > 1)
+        delay = delay / 2 + g_random_int_range(0, delay / 2 + 1);
+
+    return static_cast<int>(delay);
+}
+
+void CrashRecoveryManager::scheduleRecovery()
+{
+    qint64 nextTime = 0;
+    for (QMap<QString, CrashRecoveryInfo>::const_iterator it = m_crashRecoveryInfoMap.begin(); it != m_crashRecoveryInfoMap.end(); ++it) {
+        if (it.value().recoveryTime && (!nextTime || it.value().recoveryTime < nextTime))
+            nextTime = it.value().recoveryTime;
+    }
+
+    if (m_recoveryTimer.isRunning())
+        m_recoveryTimer.stop();
+
+    if (!nextTime)
+        return;
+
+    qint64 delay = std::max(nextTime - g_get_monotonic_time(), static_cast<qint64>(0)) / 1000;
+    m_recoveryTimer.start(static_cast<int>(delay), this, &CrashRecoveryManager::recoveryTimeout);
+}
+
+void CrashRecoveryManager::recoveryTimeout()
+{
+    // Reloads are relaunch class work, they wait for foreground and overlay launches
+    LaunchScheduler* scheduler = WebAppManager::instance()->getLaunchScheduler();
+    if (scheduler->shouldYield(LaunchScheduler::ClassRelaunch)) {
+        m_recoveryTimer.start(LaunchScheduler::kYieldIntervalMs, this, &CrashRecoveryManager::recoveryTimeout);
+        return;
+    }
+
+    qint64 now = g_get_monotonic_time();
+    QList<QString> appIds;
+    for (QMap<QString, CrashRecoveryInfo>::iterator it = m_crashRecoveryInfoMap.begin(); it != m_crashRecoveryInfoMap.end(); ++it) {
+        if (it.value().recoveryTime && it.value().recoveryTime <= now) {
+            scheduler->recordQueueDelay(LaunchScheduler::ClassRelaunch, now - it.value().recoveryTime);
+            it.value().recoveryTime = 0;
+            appIds.append(it.key());
+        }
+    }
+
+    Q_FOREACH (const QString& appId, appIds) {
+        WebAppBase* app = WebAppManager::instance()->findAppById(appId);
+        if (!app || app->isClosing())
+            continue;
+
+        CrashRecoveryInfo& info = m_crashRecoveryInfoMap[appId];
+        if (!app->isActivated() || app->getHiddenWindow()) {
+            info.deferredCount++;
+            app->setCrashState(true);
+            continue;
+        }
+
+        LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKFV("CONSECUTIVE_CRASHES", "%u", info.consecutiveCrashes), "Recover; Reload default page");
+        info.recoveryCount++;
+        scheduler->launchStarted(appId, LaunchScheduler::ClassRelaunch);
+        app->page()->reloadDefaultPage();
+    }
+
+    scheduleRecovery();
+}
+
+QJsonObject CrashRecoveryManager::getCrashRecoveryStats() const
+{
+    QJsonObject stats;
+    QJsonArray apps;
+    uint32_t totalCrashes = 0, totalRecoveries = 0;
+    qint64 now = g_get_monotonic_time();
+
+    for (QMap<QString, CrashRecoveryInfo>::const_iterator it = m_crashRecoveryInfoMap.begin(); it != m_crashRecoveryInfoMap.end(); ++it) {
+        const CrashRecoveryInfo& info = it.value();
+        QJsonObject app;
+        app["id"] = it.key();
+        app["crashCount"] = static_cast<int>(info.crashCount);
+        app["consecutiveCrashes"] = static_cast<int>(info.consecutiveCrashes);
+        app["recoveryCount"] = static_cast<int>(info.recoveryCount);
+        app["deferredCount"] = static_cast<int>(info.deferredCount);
+        app["giveUpCount"] = static_cast<int>(info.giveUpCount);
+        app["lastCrashAgoSec"] = static_cast<int>((now - info.lastCrashTime) / G_USEC_PER_SEC);
+        if (info.recoveryTime)
+            app["recoveryInMs"] = static_cast<int>(std::max(info.recoveryTime - now, static_cast<qint64>(0)) / 1000);
+        apps.append(app);
+
+        totalCrashes += info.crashCount;
+        totalRecoveries += info.recoveryCount;
+    }
+
+    stats["apps"] = apps;
+    stats["crashCount"] = static_cast<int>(totalCrashes);
+    stats["recoveryCount"] = static_cast<int>(totalRecoveries);
+    return stats;
+}
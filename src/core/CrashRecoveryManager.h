@@ -0,0 +1,69 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CRASHRECOVERYMANAGER_H
+#define CRASHRECOVERYMANAGER_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+class CrashRecoveryManager {
+public:
+    CrashRecoveryManager();
+    ~CrashRecoveryManager() {}
+
+    // Returns false when the app keeps crashing and should be closed
+    bool appCrashed(WebAppBase* app);
+    void appClosed(const QString& appId);
+    QJsonObject getCrashRecoveryStats() const;
+
+private:
+    int nextRecoveryDelay(uint32_t consecutiveCrashes) const;
+    void scheduleRecovery();
+    void recoveryTimeout();
+
+    class CrashRecoveryInfo {
+    public:
+        CrashRecoveryInfo()
+            : crashCount(0)
+            , consecutiveCrashes(0)
+            , recoveryCount(0)
+            , deferredCount(0)
+            , giveUpCount(0)
+            , lastCrashTime(0)
+            , recoveryTime(0)
+        {
+        }
+
+        uint32_t crashCount;
+        uint32_t consecutiveCrashes;
+        uint32_t recoveryCount;
+        uint32_t deferredCount; // recovered on next show
+        uint32_t giveUpCount;
+        qint64 lastCrashTime; // monotonic usecs
+        qint64 recoveryTime; // monotonic usecs, 0 when nothing is scheduled
+    };
+    QMap<QString, CrashRecoveryInfo> m_crashRecoveryInfoMap;
+
+    OneShotTimer<CrashRecoveryManager> m_recoveryTimer;
+};
+
+#endif /* CRASHRECOVERYMANAGER_H */
@@ -0,0 +1,154 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "DiskWriteBudget.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+DiskWriteBudget::DiskWriteBudget()
+{
+}
+
+void DiskWriteBudget::start()
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->isDiskWriteAccountingEnabled() || m_sampleTimer.isRunning())
+        return;
+
+    m_sampleTimer.start(config->getDiskWritePeriod() * 1000, this, &DiskWriteBudget::sampleTimeout);
+}
+
+void DiskWriteBudget::appClosed(const QString& appId)
+{
+    // Lifetime totals outlive the app, the page goes away with its blocking
+    QMap<QString, WriteInfo>::iterator it = m_writeInfoMap.find(appId);
+    if (it == m_writeInfoMap.end())
+        return;
+
+    it.value().throttled = false;
+    it.value().running = false;
+}
+
+const char* DiskWriteBudget::appClass(WebAppBase* app)
+{
+    if (app->isActivated() && !app->getHiddenWindow())
+        return "foreground";
+    if (app->preloadState() != WebAppBase::NONE_PRELOAD)
+        return "preload";
+    return "background";
+}
+
+void DiskWriteBudget::throttle(WebAppBase* app, bool throttled)
+{
+    // Partial preloads keep the disk cache blocked until they are launched
+    if (!throttled && app->preloadState() == WebAppBase::PARTIAL_PRELOAD)
+        return;
+
+    app->page()->setBlockWriteDiskcache(throttled);
+}
+
+void DiskWriteBudget::sampleTimeout()
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+
+    // Writes are per renderer, apps sharing one are charged an equal share
+    QMap<uint32_t, long long> writeBytesMap;
+    QMap<uint32_t, uint64_t> writtenMap;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (!app || !app->page() || app->isClosing())
+            continue;
+
+        uint32_t pid = app->page()->getWebProcessPID();
+        if (!pid)
+            continue;
+
+        if (!writeBytesMap.contains(pid)) {
+            long long writeBytes = WebAppManagerUtils::getProcessWriteBytes(pid);
+            writeBytesMap[pid] = writeBytes;
+
+            // A renderer seen for the first time is charged from the next period
+            long long last = m_writeBytesMap.value(pid, -1);
+            size_t appCount = std::max<size_t>(WebAppManager::instance()->runningApps(pid).size(), 1);
+            if (writeBytes >= 0 && last >= 0 && writeBytes >= last)
+                writtenMap[pid] = (writeBytes - last) / 1024 / appCount;
+        }
+
+        WriteInfo& info = m_writeInfoMap[app->appId()];
+        info.running = true;
+        info.appClass = QLatin1String(appClass(app));
+        info.budget = config->getDiskWriteBudget(info.appClass);
+        info.lastWritten = writtenMap.value(pid, 0);
+        info.totalWritten += info.lastWritten;
+
+        bool overBudget = info.budget && info.lastWritten > info.budget;
+        if (overBudget == info.throttled)
+            continue;
+
+        info.throttled = overBudget;
+        throttle(app, overBudget);
+        if (overBudget) {
+            info.violationCount++;
+            LOG_INFO(MSGID_DISK_WRITE_BUDGET, 5, PMLOGKS("APP_ID", qPrintable(app->appId())),
+                PMLOGKFV("PID", "%u", pid),
+                PMLOGKS("CLASS", qPrintable(info.appClass)),
+                PMLOGKFV("WRITTEN_KB", "%llu", static_cast<unsigned long long>(info.lastWritten)),
+                PMLOGKFV("BUDGET_KB", "%u", info.budget), "Block disk cache writes");
+        }
+    }
+
+    m_writeBytesMap = writeBytesMap;
+}
+
+QJsonObject DiskWriteBudget::getDiskWriteStats() const
+{
+    QJsonObject stats;
+    QJsonArray apps;
+    double totalWritten = 0;
+    uint32_t period = WebAppManager::instance()->config()->getDiskWritePeriod();
+
+    for (QMap<QString, WriteInfo>::const_iterator it = m_writeInfoMap.begin(); it != m_writeInfoMap.end(); ++it) {
+        const WriteInfo& info = it.value();
+
+        QJsonObject app;
+        app["id"] = it.key();
+        app["class"] = info.appClass;
+        app["running"] = info.running;
+        app["budgetInKB"] = static_cast<int>(info.budget);
+        app["writeRateInKBPerSec"] = period ? static_cast<double>(info.lastWritten) / period : 0;
+        app["totalWrittenInKB"] = static_cast<double>(info.totalWritten);
+        app["violationCount"] = static_cast<int>(info.violationCount);
+        app["throttled"] = info.throttled;
+        apps.append(app);
+
+        totalWritten += info.totalWritten;
+    }
+
+    stats["apps"] = apps;
+    stats["periodInSec"] = static_cast<int>(period);
+    stats["totalWrittenInKB"] = totalWritten;
+    return stats;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DISKWRITEBUDGET_H
+#define DISKWRITEBUDGET_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Accounts the storage writes of each renderer to the apps it hosts and
+// blocks disk cache writes of apps going over the budget of their class
+class DiskWriteBudget {
+public:
+    DiskWriteBudget();
+    ~DiskWriteBudget() {}
+
+    void start();
+    void appClosed(const QString& appId);
+    QJsonObject getDiskWriteStats() const;
+
+private:
+    void sampleTimeout();
+    static const char* appClass(WebAppBase* app);
+    void throttle(WebAppBase* app, bool throttled);
+
+    class WriteInfo {
+    public:
+        WriteInfo()
+            : budget(0)
+            , lastWritten(0)
+            , totalWritten(0)
+            , violationCount(0)
+            , throttled(false)
+            , running(true)
+        {
+        }
+
+        QString appClass;
+        uint32_t budget; // KB per period, 0 is unlimited
+        uint64_t lastWritten; // KB over the last period
+        uint64_t totalWritten; // KB since the app was first seen
+        uint32_t violationCount;
+        bool throttled;
+        bool running;
+    };
+    QMap<QString, WriteInfo> m_writeInfoMap;
+
+    QMap<uint32_t, long long> m_writeBytesMap; // last write_bytes per renderer
+    RepeatingTimer<DiskWriteBudget> m_sampleTimer;
+};
+
+#endif /* DISKWRITEBUDGET_H */
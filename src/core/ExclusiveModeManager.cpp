@@ -0,0 +1,231 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ExclusiveModeManager.h"
+
+#include <QSet>
+
+#include "ApplicationDescription.h"
+#include "CgroupManager.h"
+#include "ContainerAppManager.h"
+#include "LaunchScheduler.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// Background pages get a moment to act on the memory pressure notification
+// before their renderers are frozen
+static const int kFreezeDelayMs = 1000;
+
+ExclusiveModeManager::ExclusiveModeManager()
+    : m_launchesPaused(false)
+    , m_containerReleased(false)
+    , m_enterCount(0)
+    , m_releasedContainers(0)
+    , m_closedPreloads(0)
+    , m_frozenProcesses(0)
+    , m_refusedPreloads(0)
+    , m_enterTime(0)
+    , m_totalExclusiveTime(0)
+{
+}
+
+bool ExclusiveModeManager::isExclusiveApp(WebAppBase* app) const
+{
+    QMap<QString, bool>::const_iterator it = m_exclusiveOverrides.find(app->appId());
+    if (it != m_exclusiveOverrides.end())
+        return it.value();
+
+    return app->getAppDescription() && app->getAppDescription()->isExclusiveForeground();
+}
+
+void ExclusiveModeManager::appActivated(WebAppBase* app)
+{
+    if (app->appId() != m_exclusiveAppId && isExclusiveApp(app))
+        enter(app);
+}
+
+void ExclusiveModeManager::appDeactivated(const QString& appId)
+{
+    if (isExclusive() && appId == m_exclusiveAppId)
+        leave();
+}
+
+void ExclusiveModeManager::setExclusiveApp(const QString& appId, bool exclusive)
+{
+    m_exclusiveOverrides[appId] = exclusive;
+
+    // Takes effect right away for the app in the foreground
+    WebAppBase* app = WebAppManager::instance()->findAppById(appId);
+    if (!app || !app->page() || !app->isActivated() || app->getHiddenWindow())
+        return;
+
+    if (exclusive)
+        appActivated(app);
+    else
+        appDeactivated(appId);
+}
+
+bool ExclusiveModeManager::refusePreload(const QString& appId)
+{
+    if (!isExclusive() || appId == m_exclusiveAppId)
+        return false;
+
+    m_refusedPreloads++;
+    LOG_INFO(MSGID_EXCLUSIVE_MODE, 2, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKS("EXCLUSIVE_APP_ID", qPrintable(m_exclusiveAppId)), "Refuse preload");
+    return true;
+}
+
+void ExclusiveModeManager::enter(WebAppBase* app)
+{
+    WebAppManager* manager = WebAppManager::instance();
+    uint32_t exclusivePid = app->page()->getWebProcessPID();
+
+    // Switching straight to another exclusive app keeps everything released
+    if (isExclusive())
+        m_totalExclusiveTime += g_get_monotonic_time() - m_enterTime;
+    m_restoreTimer.stop();
+    m_exclusiveAppId = app->appId();
+    m_enterTime = g_get_monotonic_time();
+    m_enterCount++;
+
+    if (!m_launchesPaused) {
+        manager->getLaunchScheduler()->pausePreloads();
+        if (manager->getContainerAppManager())
+            manager->getContainerAppManager()->pauseWarmup();
+        m_launchesPaused = true;
+    }
+
+    // The spare container, unless the app itself was launched into it
+    WebAppBase* container = manager->getContainerApp();
+    if (container && container != app && container->page() && container->page()->getWebProcessPID() != exclusivePid) {
+        manager->closeContainerApp();
+        m_containerReleased = true;
+        m_releasedContainers++;
+    }
+
+    // Apps may be closed on the way, look each one up again
+    QStringList appIds;
+    std::list<const WebAppBase*> apps = manager->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it)
+        appIds.append((*it)->appId());
+
+    for (int i = 0; i < appIds.size(); i++) {
+        WebAppBase* other = manager->findAppById(appIds.at(i));
+        if (!other || other == app || !other->page() || other->isClosing())
+            continue;
+
+        // Prepared windows nobody has seen yet are launched again on demand
+        if (other->preloadState() != WebAppBase::NONE_PRELOAD && !other->isActivated()) {
+            manager->forceCloseAppInternal(other);
+            m_closedPreloads++;
+            continue;
+        }
+
+        if (other->page()->isEnableBackgroundRun()) {
+            if (!m_throttledAppIds.contains(other->appId())) {
+                other->page()->setBackgroundThrottled(WebPageBase::BackgroundThrottleExclusiveMode, true);
+                m_throttledAppIds.append(other->appId());
+            }
+        } else {
+            other->page()->flushSuspendDelay();
+        }
+        other->page()->notifyMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    }
+
+    m_freezeTimer.start(kFreezeDelayMs, this, &ExclusiveModeManager::freezeTimeout);
+
+    LOG_INFO(MSGID_EXCLUSIVE_MODE, 5, PMLOGKS("APP_ID", qPrintable(m_exclusiveAppId)),
+        PMLOGKFV("PID", "%u", exclusivePid),
+        PMLOGKFV("CONTAINER_RELEASED", "%d", m_containerReleased),
+        PMLOGKFV("CLOSED_PRELOADS", "%u", m_closedPreloads),
+        PMLOGKFV("THROTTLED", "%d", m_throttledAppIds.size()), "Enter exclusive mode");
+}
+
+void ExclusiveModeManager::freezeTimeout()
+{
+    WebAppManager* manager = WebAppManager::instance();
+    WebAppBase* app = manager->findAppById(m_exclusiveAppId);
+    if (!app || !app->page())
+        return;
+
+    QSet<uint32_t> excludedPids;
+    excludedPids.insert(app->page()->getWebProcessPID());
+    m_frozenProcesses += manager->getCgroupManager()->freezeWebProcesses(excludedPids).size();
+}
+
+void ExclusiveModeManager::leave()
+{
+    qint64 duration = g_get_monotonic_time() - m_enterTime;
+    m_totalExclusiveTime += duration;
+
+    LOG_INFO(MSGID_EXCLUSIVE_MODE, 2, PMLOGKS("APP_ID", qPrintable(m_exclusiveAppId)),
+        PMLOGKFV("DURATION", "%llds", static_cast<long long>(duration / G_USEC_PER_SEC)), "Leave exclusive mode");
+
+    // Restored lazily, the app often comes right back after a popup
+    m_exclusiveAppId.clear();
+    m_freezeTimer.stop();
+    m_restoreTimer.start(WebAppManager::instance()->config()->getExclusiveRestoreDelay(), this,
+        &ExclusiveModeManager::restoreTimeout);
+}
+
+void ExclusiveModeManager::restoreTimeout()
+{
+    WebAppManager* manager = WebAppManager::instance();
+
+    for (int i = 0; i < m_throttledAppIds.size(); i++) {
+        WebAppBase* app = manager->findAppById(m_throttledAppIds.at(i));
+        if (app && app->page())
+            app->page()->setBackgroundThrottled(WebPageBase::BackgroundThrottleExclusiveMode, false);
+    }
+    m_throttledAppIds.clear();
+
+    if (m_launchesPaused) {
+        manager->getLaunchScheduler()->resumePreloads();
+        if (manager->getContainerAppManager())
+            manager->getContainerAppManager()->resumeWarmup();
+        m_launchesPaused = false;
+    }
+
+#ifndef PRELOADMANAGER_ENABLED
+    if (m_containerReleased && !manager->shouldLaunchContainerAppOnDemand())
+        manager->startContainerTimer();
+#endif
+    m_containerReleased = false;
+}
+
+QJsonObject ExclusiveModeManager::getExclusiveModeStats()
+{
+    QJsonObject stats;
+    qint64 exclusiveTime = m_totalExclusiveTime;
+    if (isExclusive())
+        exclusiveTime += g_get_monotonic_time() - m_enterTime;
+
+    stats["exclusiveAppId"] = m_exclusiveAppId;
+    stats["restorePending"] = m_restoreTimer.isRunning();
+    stats["enterCount"] = static_cast<int>(m_enterCount);
+    stats["exclusiveTimeInSec"] = static_cast<int>(exclusiveTime / G_USEC_PER_SEC);
+    stats["releasedContainers"] = static_cast<int>(m_releasedContainers);
+    stats["closedPreloads"] = static_cast<int>(m_closedPreloads);
+    stats["frozenProcesses"] = static_cast<int>(m_frozenProcesses);
+    stats["refusedPreloads"] = static_cast<int>(m_refusedPreloads);
+    return stats;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef EXCLUSIVEMODEMANAGER_H
+#define EXCLUSIVEMODEMANAGER_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Gives an app with "exclusiveForeground" in its descriptor, or marked
+// through setExclusiveForeground, the device to itself while it is in the
+// foreground. The spare container and preloaded apps are closed, further
+// preloads are refused, background pages are suspended or throttled and
+// their renderers frozen. Once the app leaves the foreground launches and
+// background run apps are restored after WAM_EXCLUSIVE_RESTORE_DELAY_IN_MS,
+// frozen renderers are thawed when their app is shown again.
+class ExclusiveModeManager {
+public:
+    ExclusiveModeManager();
+    ~ExclusiveModeManager() {}
+
+    void appActivated(WebAppBase* app);
+    void appDeactivated(const QString& appId);
+    void setExclusiveApp(const QString& appId, bool exclusive);
+    bool isExclusive() const { return !m_exclusiveAppId.isEmpty(); }
+    // Returns true and counts the preload when it has to be refused
+    bool refusePreload(const QString& appId);
+    QJsonObject getExclusiveModeStats();
+
+private:
+    bool isExclusiveApp(WebAppBase* app) const;
+    void enter(WebAppBase* app);
+    void leave();
+    void freezeTimeout();
+    void restoreTimeout();
+
+    QString m_exclusiveAppId;
+    QMap<QString, bool> m_exclusiveOverrides; // set through Luna, wins over the descriptor
+    bool m_launchesPaused;
+    bool m_containerReleased;
+    QStringList m_throttledAppIds;
+    OneShotTimer<ExclusiveModeManager> m_freezeTimer;
+    OneShotTimer<ExclusiveModeManager> m_restoreTimer;
+
+    uint32_t m_enterCount;
+    uint32_t m_releasedContainers;
+    uint32_t m_closedPreloads;
+    uint32_t m_frozenProcesses;
+    uint32_t m_refusedPreloads;
+    qint64 m_enterTime; // monotonic usecs
+    qint64 m_totalExclusiveTime; // usecs
+};
+
+#endif /* EXCLUSIVEMODEMANAGER_H */
@@ -0,0 +1,177 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "IdleTaskScheduler.h"
+
+#include <algorithm>
+
+#include "LaunchScheduler.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// Idle is sampled over one check interval, a slice is as long as an idle callback deadline
+static const int kIdleCheckIntervalMs = 500;
+static const qint64 kIdleSliceUs = 50 * 1000;
+
+IdleTaskScheduler::IdleTaskScheduler()
+    : m_lastIdleTime(0)
+    , m_lastTotalTime(0)
+    , m_completedCount(0)
+    , m_starvedCount(0)
+    , m_sliceCount(0)
+    , m_totalWait(0)
+    , m_maxWait(0)
+{
+}
+
+IdleTaskScheduler::~IdleTaskScheduler()
+{
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
+        delete it->task;
+}
+
+void IdleTaskScheduler::postTask(IdleTask* task, int timeoutMs)
+{
+    PendingTask pending;
+    pending.task = task;
+    pending.postTime = g_get_monotonic_time();
+    pending.timeoutTime = pending.postTime + static_cast<qint64>(timeoutMs) * 1000;
+    m_tasks.push_back(pending);
+
+    if (!m_idleTimer.isRunning()) {
+        // The first check needs a previous sample to compare with
+        WebAppManagerUtils::getCpuTimes(m_lastIdleTime, m_lastTotalTime);
+        m_idleTimer.start(kIdleCheckIntervalMs, this, &IdleTaskScheduler::idleTimeout);
+    }
+}
+
+void IdleTaskScheduler::cancelTasks(const QString& name)
+{
+    auto it = m_tasks.begin();
+    while (it != m_tasks.end()) {
+        if (it->task->name() == name) {
+            delete it->task;
+            it = m_tasks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool IdleTaskScheduler::isCpuIdle()
+{
+    unsigned long long idleTime = 0, totalTime = 0;
+    if (!WebAppManagerUtils::getCpuTimes(idleTime, totalTime))
+        return true;
+
+    bool idle = true;
+    if (totalTime > m_lastTotalTime && idleTime >= m_lastIdleTime) {
+        unsigned long long percent = (idleTime - m_lastIdleTime) * 100 / (totalTime - m_lastTotalTime);
+        idle = percent >= WebAppManager::instance()->config()->getIdleTaskCpuIdleThreshold();
+    }
+
+    m_lastIdleTime = idleTime;
+    m_lastTotalTime = totalTime;
+    return idle;
+}
+
+bool IdleTaskScheduler::isIdle()
+{
+    // Sample every tick so the next check compares against a fresh baseline
+    bool cpuIdle = isCpuIdle();
+
+    if (WebAppManager::instance()->getLaunchScheduler()->isLaunchInFlight())
+        return false;
+
+    WebAppBase* app = WebAppManager::instance()->findAppById(WebAppManager::instance()->getActiveAppId());
+    if (app && app->page() && app->page()->progress() < 100)
+        return false;
+
+    return cpuIdle;
+}
+
+void IdleTaskScheduler::runTask(bool starved, qint64 deadline)
+{
+    PendingTask pending = m_tasks.front();
+    m_tasks.pop_front();
+
+    m_sliceCount++;
+    if (!pending.task->run(deadline)) {
+        // Preempted, other tasks get the next slice
+        m_tasks.push_back(pending);
+        return;
+    }
+
+    qint64 wait = g_get_monotonic_time() - pending.postTime;
+    m_completedCount++;
+    if (starved)
+        m_starvedCount++;
+    m_totalWait += wait;
+    m_maxWait = std::max(m_maxWait, wait);
+
+    LOG_INFO(MSGID_IDLE_TASK, 3, PMLOGKS("TASK", qPrintable(pending.task->name())),
+        PMLOGKS("STARVED", starved ? "true" : "false"),
+        PMLOGKFV("WAIT_MS", "%d", static_cast<int>(wait / 1000)), "");
+    delete pending.task;
+}
+
+void IdleTaskScheduler::idleTimeout()
+{
+    if (m_tasks.empty()) {
+        m_idleTimer.stop();
+        return;
+    }
+
+    qint64 now = g_get_monotonic_time();
+    if (!isIdle()) {
+        // A task past its timeout gets one slice even when the device is busy
+        for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+            if (it->timeoutTime <= now) {
+                m_tasks.splice(m_tasks.begin(), m_tasks, it);
+                runTask(true, now + kIdleSliceUs);
+                break;
+            }
+        }
+        return;
+    }
+
+    qint64 deadline = now + kIdleSliceUs;
+    while (!m_tasks.empty() && g_get_monotonic_time() < deadline) {
+        runTask(m_tasks.front().timeoutTime <= g_get_monotonic_time(), deadline);
+
+        // Stop at the slice boundary once a task got a launch going
+        if (WebAppManager::instance()->getLaunchScheduler()->isLaunchInFlight())
+            break;
+    }
+}
+
+QJsonObject IdleTaskScheduler::getIdleTaskStats() const
+{
+    QJsonObject stats;
+    stats["pendingCount"] = static_cast<int>(m_tasks.size());
+    stats["completedCount"] = static_cast<int>(m_completedCount);
+    stats["starvedCount"] = static_cast<int>(m_starvedCount);
+    stats["sliceCount"] = static_cast<int>(m_sliceCount);
+    stats["averageWaitInMs"] = m_completedCount ? static_cast<int>(m_totalWait / m_completedCount / 1000) : 0;
+    stats["maxWaitInMs"] = static_cast<int>(m_maxWait / 1000);
+    return stats;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IDLETASKSCHEDULER_H
+#define IDLETASKSCHEDULER_H
+
+#include <list>
+
+#include <QJsonObject>
+#include <QString>
+
+#include "Timer.h"
+
+// Deferred maintenance work run by IdleTaskScheduler. run() is given the
+// monotonic deadline of the idle period and returns false when work is left,
+// the task is then continued in a later idle period.
+class IdleTask {
+public:
+    IdleTask(const QString& name)
+        : m_name(name)
+    {
+    }
+    virtual ~IdleTask() {}
+
+    const QString& name() const { return m_name; }
+    virtual bool run(qint64 deadline) = 0;
+
+private:
+    QString m_name;
+};
+
+// requestIdleCallback-like scheduling on the main loop. Tasks run while no
+// launch is in flight, the foreground app is not loading and the CPU is idle.
+// A task that has waited longer than its timeout runs regardless.
+class IdleTaskScheduler {
+public:
+    IdleTaskScheduler();
+    ~IdleTaskScheduler();
+
+    // Takes ownership of the task
+    void postTask(IdleTask* task, int timeoutMs);
+    void cancelTasks(const QString& name);
+    QJsonObject getIdleTaskStats() const;
+
+private:
+    bool isIdle();
+    bool isCpuIdle();
+    void runTask(bool starved, qint64 deadline);
+    void idleTimeout();
+
+    class PendingTask {
+    public:
+        IdleTask* task;
+        qint64 postTime; // monotonic usecs
+        qint64 timeoutTime; // monotonic usecs
+    };
+    std::list<PendingTask> m_tasks;
+
+    unsigned long long m_lastIdleTime;
+    unsigned long long m_lastTotalTime;
+
+    uint32_t m_completedCount;
+    uint32_t m_starvedCount; // runs forced by the timeout
+    uint32_t m_sliceCount;
+    qint64 m_totalWait; // usecs, post to completion
+    qint64 m_maxWait; // usecs
+    RepeatingTimer<IdleTaskScheduler> m_idleTimer;
+};
+
+#endif /* IDLETASKSCHEDULER_H */
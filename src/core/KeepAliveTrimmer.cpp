@@ -0,0 +1,185 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "KeepAliveTrimmer.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// The renderer needs a moment to free what the notification released
+static const qint64 kMeasureDelayUs = 3 * G_USEC_PER_SEC;
+
+static const char* trimStageName(int stage)
+{
+    return stage == KeepAliveTrimmer::TrimStageFirst ? "first" : "second";
+}
+
+KeepAliveTrimmer::KeepAliveTrimmer()
+{
+    for (int i = 0; i < TrimStageCount; i++) {
+        m_trimCount[i] = 0;
+        m_totalRecovered[i] = 0;
+    }
+}
+
+qint64 KeepAliveTrimmer::trimTime(TrimStage stage) const
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    uint32_t delay = stage == TrimStageFirst ? config->getKeepAliveTrimDelay() : config->getKeepAliveSecondTrimDelay();
+    return static_cast<qint64>(delay) * G_USEC_PER_SEC;
+}
+
+void KeepAliveTrimmer::appHidden(WebAppBase* app)
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->getKeepAliveTrimDelay())
+        return;
+
+    TrimInfo& info = m_trimInfoMap[app->appId()];
+    info.hiddenTime = g_get_monotonic_time();
+    info.nextStage = TrimStageFirst;
+    info.measureTime = 0;
+
+    if (!m_staggerTimer.isRunning())
+        m_staggerTimer.start(config->getKeepAliveTrimStagger(), this, &KeepAliveTrimmer::staggerTimeout);
+}
+
+void KeepAliveTrimmer::appShown(const QString& appId)
+{
+    // Keep what was measured, a trim in flight can not be told apart from app activity
+    QMap<QString, TrimInfo>::iterator it = m_trimInfoMap.find(appId);
+    if (it == m_trimInfoMap.end())
+        return;
+
+    it.value().hiddenTime = 0;
+    it.value().measureTime = 0;
+}
+
+void KeepAliveTrimmer::appClosed(const QString& appId)
+{
+    m_trimInfoMap.remove(appId);
+}
+
+void KeepAliveTrimmer::trim(WebAppBase* app)
+{
+    TrimInfo& info = m_trimInfoMap[app->appId()];
+    info.pid = app->page()->getWebProcessPID();
+    info.pssBefore = WebAppManagerUtils::getProcessPss(info.pid);
+    info.measureTime = g_get_monotonic_time() + kMeasureDelayUs;
+
+    // The second trim goes as far as a page can without being discarded
+    webos::WebViewBase::MemoryPressureLevel level = info.nextStage == TrimStageFirst
+        ? webos::WebViewBase::MEMORY_PRESSURE_LOW
+        : webos::WebViewBase::MEMORY_PRESSURE_CRITICAL;
+    app->page()->notifyMemoryPressure(level);
+    m_trimCount[info.nextStage]++;
+
+    LOG_INFO(MSGID_KEEPALIVE_TRIM, 4, PMLOGKS("APP_ID", qPrintable(app->appId())),
+        PMLOGKFV("PID", "%u", info.pid),
+        PMLOGKS("STAGE", trimStageName(info.nextStage)),
+        PMLOGKFV("PSS_KB", "%u", info.pssBefore), "Trim hidden keepAlive app");
+}
+
+void KeepAliveTrimmer::measure(const QString& appId)
+{
+    TrimInfo& info = m_trimInfoMap[appId];
+    uint32_t pssAfter = WebAppManagerUtils::getProcessPss(info.pid);
+    uint32_t recovered = info.pssBefore > pssAfter && pssAfter ? info.pssBefore - pssAfter : 0;
+
+    info.recovered[info.nextStage] = recovered;
+    m_totalRecovered[info.nextStage] += recovered;
+    info.measureTime = 0;
+
+    LOG_INFO(MSGID_KEEPALIVE_TRIM, 3, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKS("STAGE", trimStageName(info.nextStage)),
+        PMLOGKFV("RECOVERED_KB", "%u", recovered), "");
+    info.nextStage++;
+}
+
+void KeepAliveTrimmer::staggerTimeout()
+{
+    qint64 now = g_get_monotonic_time();
+    bool waiting = false;
+    QString dueAppId;
+    qint64 dueTime = 0;
+
+    for (QMap<QString, TrimInfo>::iterator it = m_trimInfoMap.begin(); it != m_trimInfoMap.end(); ++it) {
+        TrimInfo& info = it.value();
+        if (!info.hiddenTime || info.nextStage >= TrimStageCount)
+            continue;
+
+        if (info.measureTime) {
+            if (info.measureTime <= now)
+                measure(it.key());
+            waiting = true;
+            continue;
+        }
+
+        waiting = true;
+        qint64 time = info.hiddenTime + trimTime(static_cast<TrimStage>(info.nextStage));
+        if (time <= now && (dueAppId.isEmpty() || time < dueTime)) {
+            dueAppId = it.key();
+            dueTime = time;
+        }
+    }
+
+    // One trim per tick staggers apps hidden together
+    if (!dueAppId.isEmpty()) {
+        WebAppBase* app = WebAppManager::instance()->findAppById(dueAppId);
+        if (app && app->page() && app->keepAlive() && app->getHiddenWindow() && !app->isClosing())
+            trim(app);
+        else
+            m_trimInfoMap[dueAppId].hiddenTime = 0;
+    }
+
+    if (!waiting)
+        m_staggerTimer.stop();
+}
+
+QJsonObject KeepAliveTrimmer::getKeepAliveTrimStats() const
+{
+    QJsonObject stats;
+    QJsonArray apps;
+
+    for (QMap<QString, TrimInfo>::const_iterator it = m_trimInfoMap.begin(); it != m_trimInfoMap.end(); ++it) {
+        const TrimInfo& info = it.value();
+
+        QJsonObject app;
+        app["id"] = it.key();
+        app["hidden"] = info.hiddenTime != 0;
+        app["trimmedStages"] = std::min(info.nextStage, static_cast<int>(TrimStageCount));
+        app["firstRecoveredInKB"] = static_cast<int>(info.recovered[TrimStageFirst]);
+        app["secondRecoveredInKB"] = static_cast<int>(info.recovered[TrimStageSecond]);
+        apps.append(app);
+    }
+
+    stats["apps"] = apps;
+    stats["firstTrimCount"] = static_cast<int>(m_trimCount[TrimStageFirst]);
+    stats["secondTrimCount"] = static_cast<int>(m_trimCount[TrimStageSecond]);
+    stats["firstRecoveredInKB"] = static_cast<double>(m_totalRecovered[TrimStageFirst]);
+    stats["secondRecoveredInKB"] = static_cast<double>(m_totalRecovered[TrimStageSecond]);
+    return stats;
+}
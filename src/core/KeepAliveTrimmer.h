@@ -0,0 +1,80 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef KEEPALIVETRIMMER_H
+#define KEEPALIVETRIMMER_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Sends a memory pressure notification to the page of a keepAlive app some
+// time after it is hidden and a stronger one later, one app per stagger
+// interval, and measures the PSS each trim gives back.
+class KeepAliveTrimmer {
+public:
+    enum TrimStage {
+        TrimStageFirst = 0,
+        TrimStageSecond,
+        TrimStageCount
+    };
+
+    KeepAliveTrimmer();
+    ~KeepAliveTrimmer() {}
+
+    void appHidden(WebAppBase* app);
+    void appShown(const QString& appId);
+    void appClosed(const QString& appId);
+    QJsonObject getKeepAliveTrimStats() const;
+
+private:
+    void trim(WebAppBase* app);
+    void measure(const QString& appId);
+    void staggerTimeout();
+    qint64 trimTime(TrimStage stage) const;
+
+    class TrimInfo {
+    public:
+        TrimInfo()
+            : hiddenTime(0)
+            , nextStage(TrimStageFirst)
+            , pid(0)
+            , pssBefore(0)
+            , measureTime(0)
+        {
+            for (int i = 0; i < TrimStageCount; i++)
+                recovered[i] = 0;
+        }
+
+        qint64 hiddenTime; // monotonic usecs, 0 while shown
+        int nextStage; // TrimStageCount once fully trimmed
+        uint32_t pid;
+        uint32_t pssBefore; // KB, renderer PSS before the pending trim
+        qint64 measureTime; // monotonic usecs, 0 when nothing to measure
+        uint32_t recovered[TrimStageCount]; // KB, last measured per stage
+    };
+    QMap<QString, TrimInfo> m_trimInfoMap;
+
+    uint32_t m_trimCount[TrimStageCount];
+    uint64_t m_totalRecovered[TrimStageCount]; // KB
+    RepeatingTimer<KeepAliveTrimmer> m_staggerTimer;
+};
+
+#endif /* KEEPALIVETRIMMER_H */
@@ -0,0 +1,293 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchBoost.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <vector>
+
+#include <QJsonDocument>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+#include <unistd.h>
+
+LaunchBoost::LaunchBoost()
+    : m_wamBoostCount(0)
+    , m_uclampProbed(false)
+    , m_uclampSupported(false)
+    , m_launchCount(0)
+    , m_boostedCount(0)
+    , m_baselineCount(0)
+    , m_timeoutCount(0)
+    , m_totalBoostTime(0)
+    , m_maxBoostTime(0)
+    , m_totalBoostedFirstFrameTime(0)
+    , m_boostedFirstFrameCount(0)
+    , m_totalBaselineFirstFrameTime(0)
+{
+}
+
+bool LaunchBoost::useUclamp()
+{
+    if (!WebAppManager::instance()->config()->getLaunchBoostUclampMin())
+        return false;
+
+    // uclamp.min needs a kernel with CONFIG_UCLAMP_TASK, probe it once on our own thread
+    if (!m_uclampProbed) {
+        m_uclampProbed = true;
+        m_uclampSupported = WebAppManagerUtils::setThreadUclampMin(getpid(), 0);
+        if (!m_uclampSupported)
+            LOG_INFO(MSGID_LAUNCH_BOOST, 0, "uclamp is not available, boost with nice");
+    }
+
+    return m_uclampSupported;
+}
+
+bool LaunchBoost::applyBoost(int tid, bool process, bool boosted)
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+
+    if (useUclamp()) {
+        unsigned int utilMin = boosted ? config->getLaunchBoostUclampMin() : 0;
+        return process ? WebAppManagerUtils::setProcessUclampMin(tid, utilMin) : WebAppManagerUtils::setThreadUclampMin(tid, utilMin);
+    }
+
+    return boosted ? boostNice(tid, process, config->getLaunchBoostNice()) : restoreNice(tid, process);
+}
+
+bool LaunchBoost::boostNice(int tid, bool process, int boost)
+{
+    // Nice is per thread on Linux. Each value is saved as is, so a clamped or
+    // refused change cannot make the thread drift once it is restored
+    std::vector<int> tids = process ? WebAppManagerUtils::getThreadIds(tid) : std::vector<int>(1, tid);
+    QMap<int, int>& savedNice = m_savedNiceMap[tid];
+    bool result = !tids.empty();
+    for (size_t i = 0; i < tids.size(); i++) {
+        int nice = 0;
+        if (!WebAppManagerUtils::getThreadNice(tids[i], nice)) {
+            if (errno != ESRCH)
+                result = false;
+            continue;
+        }
+
+        if (!savedNice.contains(tids[i]))
+            savedNice.insert(tids[i], nice);
+        if (!WebAppManagerUtils::setThreadNice(tids[i], nice - boost) && errno != ESRCH)
+            result = false;
+    }
+    return result;
+}
+
+bool LaunchBoost::restoreNice(int tid, bool process)
+{
+    QMap<int, int> savedNice = m_savedNiceMap.take(tid);
+    if (savedNice.isEmpty())
+        return false;
+
+    // Threads started during the boost inherited it, they get the value of the main thread
+    int mainNice = savedNice.value(tid, savedNice.begin().value());
+    std::vector<int> tids = process ? WebAppManagerUtils::getThreadIds(tid) : std::vector<int>(1, tid);
+    bool result = true;
+    for (size_t i = 0; i < tids.size(); i++) {
+        if (!WebAppManagerUtils::setThreadNice(tids[i], savedNice.value(tids[i], mainNice)) && errno != ESRCH)
+            result = false;
+    }
+    return result;
+}
+
+void LaunchBoost::begin(const QString& appId, const std::string& params)
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->isLaunchBoostEnabled() || m_boostMap.contains(appId))
+        return;
+
+    // Preloads are not on anyone's critical path
+    QJsonObject obj = QJsonDocument::fromJson(params.c_str()).object();
+    if (obj["preload"].isString() || obj["launchedHidden"].toBool())
+        return;
+
+    Boost boost;
+    boost.startTime = g_get_monotonic_time();
+    uint32_t holdback = config->getLaunchBoostHoldback();
+    boost.boosted = !holdback || ++m_launchCount % holdback;
+    m_boostMap.insert(appId, boost);
+
+    if (boost.boosted && m_wamBoostCount++ == 0 && !applyBoost(getpid(), false, true))
+        LOG_WARNING(MSGID_LAUNCH_BOOST, 0, "Fail to boost WAM main thread");
+
+    // A relaunched app already has its renderer
+    WebAppBase* app = WebAppManager::instance()->findAppById(appId);
+    if (app && app->page() && app->page()->getWebProcessPID())
+        webProcessCreated(appId, app->page()->getWebProcessPID());
+
+    scheduleTimeout();
+}
+
+void LaunchBoost::webProcessCreated(const QString& appId, uint32_t pid)
+{
+    QMap<QString, Boost>::iterator it = m_boostMap.find(appId);
+    if (it == m_boostMap.end() || it.value().pid || !pid)
+        return;
+
+    it.value().pid = pid;
+    if (it.value().boosted)
+        boostWebProcess(pid, true);
+}
+
+void LaunchBoost::boostWebProcess(uint32_t pid, bool boosted)
+{
+    // Renderers shared by several launching apps are boosted once
+    int& count = m_webProcessBoostCount[pid];
+    if (boosted) {
+        if (count++ == 0 && !applyBoost(pid, true, true))
+            LOG_WARNING(MSGID_LAUNCH_BOOST, 1, PMLOGKFV("PID", "%u", pid), "Fail to boost renderer");
+        return;
+    }
+
+    // The renderer may have exited meanwhile, nothing to restore then
+    if (--count == 0) {
+        m_webProcessBoostCount.remove(pid);
+        applyBoost(pid, true, false);
+    }
+}
+
+void LaunchBoost::frameSwapped(const QString& appId)
+{
+    if (m_boostMap.contains(appId))
+        end(appId, false);
+}
+
+void LaunchBoost::cancel(const QString& appId)
+{
+    QMap<QString, Boost>::iterator it = m_boostMap.find(appId);
+    if (it == m_boostMap.end())
+        return;
+
+    // A failed launch is neither a success nor a timeout of the boost
+    if (it.value().boosted) {
+        if (it.value().pid)
+            boostWebProcess(it.value().pid, false);
+        if (--m_wamBoostCount == 0)
+            applyBoost(getpid(), false, false);
+    }
+    m_boostMap.erase(it);
+    scheduleTimeout();
+}
+
+void LaunchBoost::end(const QString& appId, bool timedOut)
+{
+    Boost boost = m_boostMap.take(appId);
+    qint64 duration = g_get_monotonic_time() - boost.startTime;
+
+    if (!boost.boosted) {
+        if (!timedOut) {
+            m_baselineCount++;
+            m_totalBaselineFirstFrameTime += duration;
+        }
+        LOG_INFO(MSGID_LAUNCH_BOOST, 2, PMLOGKS("APP_ID", qPrintable(appId)),
+            PMLOGKFV("FIRST_FRAME_MS", "%lld", static_cast<long long>(timedOut ? -1 : duration / 1000)), "Baseline launch");
+        scheduleTimeout();
+        return;
+    }
+
+    if (boost.pid)
+        boostWebProcess(boost.pid, false);
+    if (--m_wamBoostCount == 0)
+        applyBoost(getpid(), false, false);
+
+    m_boostedCount++;
+    m_totalBoostTime += duration;
+    m_maxBoostTime = std::max(m_maxBoostTime, duration);
+    if (timedOut) {
+        m_timeoutCount++;
+    } else {
+        m_boostedFirstFrameCount++;
+        m_totalBoostedFirstFrameTime += duration;
+    }
+
+    LOG_INFO(MSGID_LAUNCH_BOOST, 4, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKFV("PID", "%u", boost.pid),
+        PMLOGKFV("BOOST_MS", "%lld", static_cast<long long>(duration / 1000)),
+        PMLOGKS("END", timedOut ? "timeout" : "frame"), "Launch boost ended");
+    scheduleTimeout();
+}
+
+void LaunchBoost::scheduleTimeout()
+{
+    if (m_timeoutTimer.isRunning())
+        m_timeoutTimer.stop();
+
+    if (m_boostMap.isEmpty())
+        return;
+
+    qint64 oldest = m_boostMap.begin().value().startTime;
+    for (QMap<QString, Boost>::const_iterator it = m_boostMap.begin(); it != m_boostMap.end(); ++it)
+        oldest = std::min(oldest, it.value().startTime);
+
+    qint64 deadline = oldest + static_cast<qint64>(WebAppManager::instance()->config()->getLaunchBoostTimeout()) * 1000;
+    int delay = static_cast<int>(std::max<qint64>(deadline - g_get_monotonic_time(), 0) / 1000);
+    m_timeoutTimer.start(delay, this, &LaunchBoost::timeout);
+}
+
+void LaunchBoost::timeout()
+{
+    qint64 timeoutUs = static_cast<qint64>(WebAppManager::instance()->config()->getLaunchBoostTimeout()) * 1000;
+    qint64 now = g_get_monotonic_time();
+
+    QList<QString> appIds = m_boostMap.keys();
+    Q_FOREACH (const QString& appId, appIds) {
+        if (now - m_boostMap.value(appId).startTime >= timeoutUs)
+            end(appId, true);
+    }
+
+    scheduleTimeout();
+}
+
+QJsonObject LaunchBoost::getLaunchBoostStats() const
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    QJsonObject stats;
+
+    stats["enabled"] = config->isLaunchBoostEnabled();
+    stats["method"] = m_uclampSupported ? QStringLiteral("uclamp") : QStringLiteral("nice");
+    stats["timeoutInMs"] = static_cast<int>(config->getLaunchBoostTimeout());
+    stats["boostedLaunches"] = static_cast<int>(m_boostedCount);
+    stats["baselineLaunches"] = static_cast<int>(m_baselineCount);
+    stats["timeouts"] = static_cast<int>(m_timeoutCount);
+    stats["averageBoostInMs"] = m_boostedCount ? static_cast<double>(m_totalBoostTime / m_boostedCount / 1000) : 0;
+    stats["maxBoostInMs"] = static_cast<double>(m_maxBoostTime / 1000);
+
+    // Launch-time improvement is the first frame time of baseline launches
+    // against boosted ones, both counted only when a frame was swapped
+    if (m_boostedFirstFrameCount) {
+        qint64 boosted = m_totalBoostedFirstFrameTime / m_boostedFirstFrameCount / 1000;
+        stats["averageFirstFrameInMs"] = static_cast<double>(boosted);
+        if (m_baselineCount) {
+            qint64 baseline = m_totalBaselineFirstFrameTime / m_baselineCount / 1000;
+            stats["averageBaselineFirstFrameInMs"] = static_cast<double>(baseline);
+            stats["improvementInMs"] = static_cast<double>(baseline - boosted);
+        }
+    }
+    return stats;
+}
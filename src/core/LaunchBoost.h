@@ -0,0 +1,86 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHBOOST_H
+#define LAUNCHBOOST_H
+
+#include <string>
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+// Raises the scheduling priority of the WAM main thread and the renderer of a
+// launching app until its first frame is swapped or the boost times out.
+// Every WAM_LAUNCH_BOOST_HOLDBACK-th launch runs without a boost as baseline.
+class LaunchBoost {
+public:
+    LaunchBoost();
+    ~LaunchBoost() {}
+
+    void begin(const QString& appId, const std::string& params);
+    void cancel(const QString& appId);
+    void webProcessCreated(const QString& appId, uint32_t pid);
+    void frameSwapped(const QString& appId);
+    QJsonObject getLaunchBoostStats() const;
+
+private:
+    void end(const QString& appId, bool timedOut);
+    void boostWebProcess(uint32_t pid, bool boosted);
+    bool useUclamp();
+    bool applyBoost(int tid, bool process, bool boosted);
+    bool boostNice(int tid, bool process, int boost);
+    bool restoreNice(int tid, bool process);
+    void scheduleTimeout();
+    void timeout();
+
+    class Boost {
+    public:
+        Boost()
+            : startTime(0)
+            , pid(0)
+            , boosted(false)
+        {
+        }
+
+        qint64 startTime; // monotonic usecs
+        uint32_t pid;
+        bool boosted; // false for baseline launches
+    };
+    QMap<QString, Boost> m_boostMap;
+
+    int m_wamBoostCount; // boosted launches in flight
+    QMap<uint32_t, int> m_webProcessBoostCount;
+    // Nice of each thread before the boost, keyed by the boosted pid or tid
+    QMap<int, QMap<int, int> > m_savedNiceMap;
+    bool m_uclampProbed;
+    bool m_uclampSupported;
+
+    uint32_t m_launchCount;
+    uint32_t m_boostedCount;
+    uint32_t m_baselineCount;
+    uint32_t m_timeoutCount;
+    qint64 m_totalBoostTime; // usecs
+    qint64 m_maxBoostTime; // usecs
+    qint64 m_totalBoostedFirstFrameTime; // usecs, boosted launches reaching a frame
+    uint32_t m_boostedFirstFrameCount;
+    qint64 m_totalBaselineFirstFrameTime; // usecs
+    OneShotTimer<LaunchBoost> m_timeoutTimer;
+};
+
+#endif /* LAUNCHBOOST_H */
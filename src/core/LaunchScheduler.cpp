@@ -0,0 +1,255 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchScheduler.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WindowTypes.h"
+
+#include <glib.h>
+
+// A launch that never swaps a frame stops holding back other work after this
+static const qint64 kInFlightTimeoutUs = 5 * G_USEC_PER_SEC;
+
+LaunchScheduler::LaunchScheduler()
+    : m_bootTime(g_get_monotonic_time())
+    , m_lastPreloadTime(0)
+    , m_preloadPauseCount(0)
+{
+    for (int i = 0; i < ClassCount; i++) {
+        m_scheduledCount[i] = 0;
+        m_delayedCount[i] = 0;
+        m_totalQueueDelay[i] = 0;
+        m_maxQueueDelay[i] = 0;
+    }
+}
+
+LaunchScheduler::LaunchClass LaunchScheduler::launchClass(const QString& winType, const std::string& params)
+{
+    QJsonObject obj = QJsonDocument::fromJson(params.c_str()).object();
+    if (obj["preload"].isString() || obj["launchedHidden"].toBool())
+        return ClassPreload;
+
+    if (winType == WT_OVERLAY || winType == WT_POPUP || winType == WT_SYSTEM_UI)
+        return ClassOverlay;
+
+    return ClassForeground;
+}
+
+const char* LaunchScheduler::className(int launchClass)
+{
+    switch (launchClass) {
+    case ClassForeground:
+        return "foreground";
+    case ClassOverlay:
+        return "overlay";
+    case ClassRelaunch:
+        return "relaunch";
+    case ClassPreload:
+        return "preload";
+    default:
+        return "warmup";
+    }
+}
+
+void LaunchScheduler::launchStarted(const QString& appId, LaunchClass launchClass)
+{
+    InFlightLaunch& launch = m_inFlightMap[appId];
+    launch.launchClass = launchClass;
+    launch.startTime = g_get_monotonic_time();
+}
+
+void LaunchScheduler::launchFinished(const QString& appId)
+{
+    m_inFlightMap.remove(appId);
+}
+
+int LaunchScheduler::coldLaunchTime(const QString& appId) const
+{
+    QMap<QString, InFlightLaunch>::const_iterator it = m_inFlightMap.find(appId);
+    if (it == m_inFlightMap.end() || it.value().launchClass > ClassOverlay)
+        return 0;
+
+    return static_cast<int>((g_get_monotonic_time() - it.value().startTime) / 1000);
+}
+
+void LaunchScheduler::expireInFlight()
+{
+    qint64 now = g_get_monotonic_time();
+    QMap<QString, InFlightLaunch>::iterator it = m_inFlightMap.begin();
+    while (it != m_inFlightMap.end()) {
+        if (now - it.value().startTime > kInFlightTimeoutUs)
+            it = m_inFlightMap.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool LaunchScheduler::shouldYield(LaunchClass launchClass)
+{
+    expireInFlight();
+    for (QMap<QString, InFlightLaunch>::const_iterator it = m_inFlightMap.begin(); it != m_inFlightMap.end(); ++it) {
+        if (it.value().launchClass < launchClass)
+            return true;
+    }
+    return false;
+}
+
+bool LaunchScheduler::isLaunchInFlight()
+{
+    expireInFlight();
+    return !m_inFlightMap.isEmpty();
+}
+
+void LaunchScheduler::recordQueueDelay(LaunchClass launchClass, qint64 delay)
+{
+    m_scheduledCount[launchClass]++;
+    if (delay <= 0)
+        return;
+
+    m_delayedCount[launchClass]++;
+    m_totalQueueDelay[launchClass] += delay;
+    m_maxQueueDelay[launchClass] = std::max(m_maxQueueDelay[launchClass], delay);
+
+    LOG_INFO(MSGID_LAUNCH_SCHEDULER, 2, PMLOGKS("CLASS", className(launchClass)),
+        PMLOGKFV("QUEUE_DELAY_MS", "%d", static_cast<int>(delay / 1000)), "");
+}
+
+bool LaunchScheduler::canStartPreload()
+{
+    if (m_preloadPauseCount || shouldYield(ClassPreload))
+        return false;
+
+    // Preloads arriving together at boot are staggered
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    qint64 now = g_get_monotonic_time();
+    qint64 bootSequence = static_cast<qint64>(config->getBootSequenceDuration()) * G_USEC_PER_SEC;
+    qint64 stagger = static_cast<qint64>(config->getPreloadStagger()) * 1000;
+    if (now - m_bootTime < bootSequence && m_lastPreloadTime && now - m_lastPreloadTime < stagger)
+        return false;
+
+    return true;
+}
+
+bool LaunchScheduler::queuePreload(const QString& appId, const std::string& appDescString, const std::string& params,
+    const std::string& launchingAppId, const std::string& instanceId)
+{
+    // The newest request for an app replaces the one still waiting
+    cancelPreload(appId);
+
+    if (m_preloadQueue.empty() && canStartPreload()) {
+        m_lastPreloadTime = g_get_monotonic_time();
+        recordQueueDelay(ClassPreload, 0);
+        return false;
+    }
+
+    QueuedPreload preload;
+    preload.appId = appId;
+    preload.appDescString = appDescString;
+    preload.params = params;
+    preload.launchingAppId = launchingAppId;
+    preload.instanceId = instanceId;
+    preload.queueTime = g_get_monotonic_time();
+    m_preloadQueue.push_back(preload);
+
+    LOG_INFO(MSGID_LAUNCH_SCHEDULER, 2, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKFV("QUEUED", "%d", static_cast<int>(m_preloadQueue.size())), "Preload queued");
+
+    if (!m_dispatchTimer.isRunning())
+        m_dispatchTimer.start(kYieldIntervalMs, this, &LaunchScheduler::dispatchTimeout);
+    return true;
+}
+
+bool LaunchScheduler::cancelPreload(const QString& appId)
+{
+    for (auto it = m_preloadQueue.begin(); it != m_preloadQueue.end(); ++it) {
+        if (it->appId == appId) {
+            m_preloadQueue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void LaunchScheduler::pausePreloads()
+{
+    m_preloadPauseCount++;
+}
+
+void LaunchScheduler::resumePreloads()
+{
+    if (!m_preloadPauseCount || --m_preloadPauseCount)
+        return;
+
+    if (!m_preloadQueue.empty() && !m_dispatchTimer.isRunning())
+        m_dispatchTimer.start(kYieldIntervalMs, this, &LaunchScheduler::dispatchTimeout);
+}
+
+void LaunchScheduler::dispatchTimeout()
+{
+    // Paused preloads wait without ticking, resumePreloads() picks them up
+    if (m_preloadQueue.empty() || m_preloadPauseCount) {
+        m_dispatchTimer.stop();
+        return;
+    }
+
+    if (!canStartPreload())
+        return;
+
+    QueuedPreload preload = m_preloadQueue.front();
+    m_preloadQueue.pop_front();
+
+    m_lastPreloadTime = g_get_monotonic_time();
+    recordQueueDelay(ClassPreload, m_lastPreloadTime - preload.queueTime);
+    WebAppManager::instance()->launchQueuedPreload(preload.appDescString, preload.params,
+        preload.launchingAppId, preload.instanceId);
+}
+
+QJsonObject LaunchScheduler::getLaunchSchedulerStats() const
+{
+    QJsonObject stats;
+    QJsonArray classes;
+
+    for (int i = 0; i < ClassCount; i++) {
+        QJsonObject launchClass;
+        launchClass["class"] = className(i);
+        launchClass["scheduledCount"] = static_cast<int>(m_scheduledCount[i]);
+        launchClass["delayedCount"] = static_cast<int>(m_delayedCount[i]);
+        launchClass["averageQueueDelayInMs"] = m_scheduledCount[i] ? static_cast<int>(m_totalQueueDelay[i] / m_scheduledCount[i] / 1000) : 0;
+        launchClass["maxQueueDelayInMs"] = static_cast<int>(m_maxQueueDelay[i] / 1000);
+        classes.append(launchClass);
+    }
+
+    QJsonArray inFlight;
+    for (QMap<QString, InFlightLaunch>::const_iterator it = m_inFlightMap.begin(); it != m_inFlightMap.end(); ++it) {
+        QJsonObject launch;
+        launch["id"] = it.key();
+        launch["class"] = className(it.value().launchClass);
+        inFlight.append(launch);
+    }
+
+    stats["classes"] = classes;
+    stats["inFlight"] = inFlight;
+    stats["queuedPreloads"] = static_cast<int>(m_preloadQueue.size());
+    return stats;
+}
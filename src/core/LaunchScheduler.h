@@ -0,0 +1,112 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHSCHEDULER_H
+#define LAUNCHSCHEDULER_H
+
+#include <list>
+#include <string>
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "Timer.h"
+
+// Orders launch work on the main loop by priority class. Work of a lower class
+// yields at its stage boundaries while a launch of a higher class has not yet
+// swapped its first frame. During boot, preloads are additionally started no
+// closer than WAM_PRELOAD_STAGGER_IN_MS apart.
+class LaunchScheduler {
+public:
+    enum LaunchClass {
+        ClassForeground = 0,
+        ClassOverlay,
+        ClassRelaunch,
+        ClassPreload,
+        ClassWarmup,
+        ClassCount
+    };
+
+    // Retry interval of work that yielded
+    static const int kYieldIntervalMs = 100;
+
+    LaunchScheduler();
+    ~LaunchScheduler() {}
+
+    static LaunchClass launchClass(const QString& winType, const std::string& params);
+
+    void launchStarted(const QString& appId, LaunchClass launchClass);
+    void launchFinished(const QString& appId);
+    // Time in ms since a foreground or overlay launch in flight started, 0 for none
+    int coldLaunchTime(const QString& appId) const;
+    bool shouldYield(LaunchClass launchClass);
+    bool isLaunchInFlight();
+    void recordQueueDelay(LaunchClass launchClass, qint64 delay);
+
+    // Returns true when the preload was queued to be launched later
+    bool queuePreload(const QString& appId, const std::string& appDescString, const std::string& params,
+        const std::string& launchingAppId, const std::string& instanceId);
+    bool cancelPreload(const QString& appId);
+    // Nested, preloads start again once every pause is resumed
+    void pausePreloads();
+    void resumePreloads();
+
+    QJsonObject getLaunchSchedulerStats() const;
+
+private:
+    void expireInFlight();
+    bool canStartPreload();
+    void dispatchTimeout();
+    static const char* className(int launchClass);
+
+    class InFlightLaunch {
+    public:
+        InFlightLaunch()
+            : launchClass(ClassForeground)
+            , startTime(0)
+        {
+        }
+
+        LaunchClass launchClass;
+        qint64 startTime; // monotonic usecs
+    };
+    QMap<QString, InFlightLaunch> m_inFlightMap;
+
+    class QueuedPreload {
+    public:
+        QString appId;
+        std::string appDescString;
+        std::string params;
+        std::string launchingAppId;
+        std::string instanceId;
+        qint64 queueTime; // monotonic usecs
+    };
+    std::list<QueuedPreload> m_preloadQueue;
+
+    qint64 m_bootTime; // monotonic usecs
+    qint64 m_lastPreloadTime; // monotonic usecs
+    int m_preloadPauseCount;
+
+    uint32_t m_scheduledCount[ClassCount];
+    uint32_t m_delayedCount[ClassCount];
+    qint64 m_totalQueueDelay[ClassCount]; // usecs
+    qint64 m_maxQueueDelay[ClassCount]; // usecs
+
+    RepeatingTimer<LaunchScheduler> m_dispatchTimer;
+};
+
+#endif /* LAUNCHSCHEDULER_H */
@@ -0,0 +1,295 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LowPowerManager.h"
+
+#include <unistd.h>
+
+#include <QJsonArray>
+#include <QSet>
+
+#include "CgroupManager.h"
+#include "ContainerAppManager.h"
+#include "LaunchScheduler.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+// Pause between the stages of leaving low-power mode, one renderer is
+// thawed per stage
+static const int kExitStageIntervalMs = 250;
+
+static const char* powerModeName(int mode)
+{
+    return mode == LowPowerManager::ModeLowPower ? "lowPower" : "normal";
+}
+
+LowPowerManager::LowPowerManager()
+    : m_powerState(QLatin1String("active"))
+    , m_lowPower(false)
+    , m_exitStage(ExitStageDone)
+    , m_exitStartTime(0)
+    , m_enterCount(0)
+    , m_lastSuspendedCount(0)
+    , m_lastFrozenCount(0)
+    , m_lastExitDuration(0)
+    , m_sampleTime(0)
+{
+    for (int i = 0; i < ModeCount; i++) {
+        m_wakeups[i] = 0;
+        m_modeTime[i] = 0;
+    }
+}
+
+bool LowPowerManager::setPowerState(const QString& state)
+{
+    bool lowPower;
+    if (state == QLatin1String("active"))
+        lowPower = false;
+    else if (state == QLatin1String("screenOff") || state == QLatin1String("screenSaver") || state == QLatin1String("standby"))
+        lowPower = true;
+    else
+        return false;
+
+    m_powerState = state;
+    if (lowPower == m_lowPower)
+        return true;
+
+    // Wakeups so far belong to the mode being left
+    accountWakeups();
+    if (lowPower)
+        enter();
+    else
+        exit();
+    return true;
+}
+
+bool LowPowerManager::isExemptApp(WebAppBase* app) const
+{
+    // The spare container is idle and must stay ready for the next launch
+    if (app == WebAppManager::instance()->getContainerApp())
+        return true;
+
+    return WebAppManager::instance()->config()->isLowPowerExemptApp(app->appId());
+}
+
+void LowPowerManager::enter()
+{
+    WebAppManager* manager = WebAppManager::instance();
+    unsigned long slackNs = static_cast<unsigned long>(manager->config()->getLowPowerTimerSlack()) * 1000;
+
+    // A staged exit still in progress picks up from what it has not restored
+    // yet, launches are still paused then
+    bool launchesPaused = m_exitStage != ExitStageDone;
+    m_lowPower = true;
+    m_enterCount++;
+    m_exitStage = ExitStageDone;
+    m_exitTimer.stop();
+
+    // Timers of the main loop may fire late by the slack and get batched
+    if (slackNs)
+        WebAppManagerUtils::setTimerSlack(slackNs);
+
+    QSet<uint32_t> exemptPids;
+    QSet<uint32_t> pids;
+    std::list<const WebAppBase*> apps = manager->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = manager->findAppById((*it)->appId());
+        if (!app || !app->page() || app->isClosing())
+            continue;
+
+        uint32_t pid = app->page()->getWebProcessPID();
+        if (isExemptApp(app)) {
+            exemptPids.insert(pid);
+            continue;
+        }
+        pids.insert(pid);
+
+        // Background run pages are never suspended, their DOM is held instead
+        if (app->page()->isEnableBackgroundRun() && !m_throttledAppIds.contains(app->appId())) {
+            app->page()->setBackgroundThrottled(WebPageBase::BackgroundThrottleLowPower, true);
+            m_throttledAppIds.append(app->appId());
+        }
+
+        if (app->isActivated() && !app->getHiddenWindow()) {
+            if (!m_suspendedAppIds.contains(app->appId())) {
+                app->page()->suspendWebPageAll();
+                m_suspendedAppIds.append(app->appId());
+            }
+        }
+        app->page()->flushSuspendDelay();
+    }
+    pids.remove(0);
+    pids.subtract(exemptPids);
+
+    if (slackNs) {
+        for (QSet<uint32_t>::const_iterator it = pids.begin(); it != pids.end(); ++it) {
+            if (!m_slackPids.contains(*it) && WebAppManagerUtils::setProcessTimerSlack(*it, slackNs))
+                m_slackPids.append(*it);
+        }
+    }
+
+    if (!launchesPaused) {
+        manager->getLaunchScheduler()->pausePreloads();
+        if (manager->getContainerAppManager())
+            manager->getContainerAppManager()->pauseWarmup();
+    }
+
+    // The foreground renderer stays in its cgroup, only its page is suspended
+    QList<uint32_t> frozenPids = manager->getCgroupManager()->freezeWebProcesses(exemptPids);
+    for (int i = 0; i < frozenPids.size(); i++) {
+        if (!m_frozenPids.contains(frozenPids.at(i)))
+            m_frozenPids.append(frozenPids.at(i));
+    }
+
+    m_lastSuspendedCount = m_suspendedAppIds.size();
+    m_lastFrozenCount = m_frozenPids.size();
+    LOG_INFO(MSGID_LOW_POWER, 4, PMLOGKS("STATE", qPrintable(m_powerState)),
+        PMLOGKFV("SUSPENDED", "%u", m_lastSuspendedCount),
+        PMLOGKFV("THROTTLED", "%d", m_throttledAppIds.size()),
+        PMLOGKFV("FROZEN", "%u", m_lastFrozenCount), "Enter low-power mode");
+}
+
+void LowPowerManager::exit()
+{
+    m_lowPower = false;
+    m_exitStage = ExitStageForeground;
+    m_exitStartTime = g_get_monotonic_time();
+
+    // The foreground app comes back right away, the rest in stages
+    exitStageTimeout();
+    if (m_exitStage != ExitStageDone)
+        m_exitTimer.start(kExitStageIntervalMs, this, &LowPowerManager::exitStageTimeout);
+}
+
+void LowPowerManager::exitStageTimeout()
+{
+    WebAppManager* manager = WebAppManager::instance();
+
+    switch (m_exitStage) {
+    case ExitStageForeground:
+        WebAppManagerUtils::setTimerSlack(0);
+        for (int i = 0; i < m_suspendedAppIds.size(); i++) {
+            WebAppBase* app = manager->findAppById(m_suspendedAppIds.at(i));
+            if (!app || !app->page() || app->isClosing())
+                continue;
+
+            manager->getCgroupManager()->thawWebProcess(app->page()->getWebProcessPID());
+            // Apps sent to the background meanwhile stay suspended
+            if (app->isActivated() && !app->getHiddenWindow())
+                app->page()->resumeWebPageAll();
+        }
+        m_suspendedAppIds.clear();
+        m_exitStage = ExitStageRenderers;
+        break;
+    case ExitStageRenderers:
+        if (!m_frozenPids.isEmpty()) {
+            manager->getCgroupManager()->thawWebProcess(m_frozenPids.takeFirst());
+            break;
+        }
+        for (int i = 0; i < m_slackPids.size(); i++)
+            WebAppManagerUtils::setProcessTimerSlack(m_slackPids.at(i), 0);
+        m_slackPids.clear();
+        m_exitStage = ExitStageBackgroundRun;
+        break;
+    case ExitStageBackgroundRun:
+        for (int i = 0; i < m_throttledAppIds.size(); i++) {
+            WebAppBase* app = manager->findAppById(m_throttledAppIds.at(i));
+            if (app && app->page())
+                app->page()->setBackgroundThrottled(WebPageBase::BackgroundThrottleLowPower, false);
+        }
+        m_throttledAppIds.clear();
+        m_exitStage = ExitStageLaunches;
+        break;
+    case ExitStageLaunches:
+        manager->getLaunchScheduler()->resumePreloads();
+        if (manager->getContainerAppManager())
+            manager->getContainerAppManager()->resumeWarmup();
+        m_exitStage = ExitStageDone;
+        m_lastExitDuration = g_get_monotonic_time() - m_exitStartTime;
+        m_exitTimer.stop();
+        LOG_INFO(MSGID_LOW_POWER, 2, PMLOGKS("STATE", qPrintable(m_powerState)),
+            PMLOGKFV("DURATION", "%lldms", static_cast<long long>(m_lastExitDuration / 1000)), "Leave low-power mode");
+        break;
+    default:
+        m_exitTimer.stop();
+        break;
+    }
+}
+
+void LowPowerManager::accountWakeups()
+{
+    WebAppManager* manager = WebAppManager::instance();
+    qint64 now = g_get_monotonic_time();
+
+    QSet<int> pids;
+    pids.insert(getpid());
+    std::list<const WebAppBase*> apps = manager->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        if ((*it)->page() && (*it)->page()->getWebProcessPID())
+            pids.insert((*it)->page()->getWebProcessPID());
+    }
+
+    // A renderer started since the last sample counts from this one on
+    QMap<int, long> contextSwitches;
+    int mode = m_lowPower ? ModeLowPower : ModeNormal;
+    for (QSet<int>::const_iterator it = pids.begin(); it != pids.end(); ++it) {
+        long switches = WebAppManagerUtils::getProcessContextSwitches(*it);
+        if (switches < 0)
+            continue;
+
+        contextSwitches[*it] = switches;
+        QMap<int, long>::const_iterator last = m_contextSwitches.find(*it);
+        if (last != m_contextSwitches.end() && switches >= last.value())
+            m_wakeups[mode] += switches - last.value();
+    }
+
+    if (m_sampleTime)
+        m_modeTime[mode] += now - m_sampleTime;
+    m_contextSwitches = contextSwitches;
+    m_sampleTime = now;
+}
+
+QJsonObject LowPowerManager::getLowPowerStats()
+{
+    accountWakeups();
+
+    QJsonObject stats;
+    QJsonArray modes;
+    for (int i = 0; i < ModeCount; i++) {
+        QJsonObject mode;
+        mode["mode"] = powerModeName(i);
+        mode["timeInSec"] = static_cast<int>(m_modeTime[i] / G_USEC_PER_SEC);
+        mode["wakeupsPerSec"] = m_modeTime[i] ? m_wakeups[i] * G_USEC_PER_SEC / m_modeTime[i] : 0;
+        modes.append(mode);
+    }
+
+    stats["powerState"] = m_powerState;
+    stats["lowPower"] = m_lowPower;
+    stats["exiting"] = !m_lowPower && m_exitStage != ExitStageDone;
+    stats["enterCount"] = static_cast<int>(m_enterCount);
+    stats["lastSuspendedApps"] = static_cast<int>(m_lastSuspendedCount);
+    stats["lastFrozenProcesses"] = static_cast<int>(m_lastFrozenCount);
+    stats["lastExitDurationInMs"] = static_cast<int>(m_lastExitDuration / 1000);
+    stats["timerSlackInUs"] = static_cast<int>(WebAppManager::instance()->config()->getLowPowerTimerSlack());
+    stats["modes"] = modes;
+    return stats;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LOWPOWERMANAGER_H
+#define LOWPOWERMANAGER_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+// Follows the system power state. While the screen is off every app not in
+// WAM_LOW_POWER_EXEMPT_APPS is suspended at once, background run apps are
+// throttled, preloads and container warmup wait, timer slack is raised and
+// idle renderers are frozen. Leaving it restores the foreground app first
+// and the rest in stages, so waking the screen is not slowed down.
+class LowPowerManager {
+public:
+    enum PowerMode {
+        ModeNormal = 0,
+        ModeLowPower,
+        ModeCount
+    };
+
+    LowPowerManager();
+    ~LowPowerManager() {}
+
+    // "active", "screenOff", "screenSaver" or "standby"
+    bool setPowerState(const QString& state);
+    bool isLowPower() const { return m_lowPower; }
+    QJsonObject getLowPowerStats();
+
+private:
+    enum ExitStage {
+        ExitStageForeground = 0,
+        ExitStageRenderers,
+        ExitStageBackgroundRun,
+        ExitStageLaunches,
+        ExitStageDone
+    };
+
+    void enter();
+    void exit();
+    void exitStageTimeout();
+    bool isExemptApp(WebAppBase* app) const;
+    void accountWakeups();
+
+    QString m_powerState;
+    bool m_lowPower;
+    int m_exitStage;
+    qint64 m_exitStartTime; // monotonic usecs
+    QStringList m_suspendedAppIds;
+    QStringList m_throttledAppIds;
+    QList<uint32_t> m_frozenPids;
+    QList<uint32_t> m_slackPids;
+    RepeatingTimer<LowPowerManager> m_exitTimer;
+
+    uint32_t m_enterCount;
+    uint32_t m_lastSuspendedCount;
+    uint32_t m_lastFrozenCount;
+    qint64 m_lastExitDuration; // usecs
+
+    // Context switches of WAM and the renderers stand in for wakeups
+    QMap<int, long> m_contextSwitches; // by pid, at the last sample
+    qint64 m_sampleTime; // monotonic usecs
+    double m_wakeups[ModeCount];
+    qint64 m_modeTime[ModeCount]; // usecs
+};
+
+#endif /* LOWPOWERMANAGER_H */
@@ -0,0 +1,296 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PreloadAdmission.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppManagerUtils.h"
+#include "WebPageBase.h"
+
+#include <glib.h>
+
+static const int kRetryIntervalMs = 2000;
+static const size_t kMaxDeferredLaunches = 4;
+static const qint64 kDeferTimeoutUs = 60 * G_USEC_PER_SEC;
+
+// Same mapping as WebAppBase::setPreloadState(), 0 is a foreground launch
+static int preloadPriority(const std::string& params)
+{
+    QJsonObject obj = QJsonDocument::fromJson(params.c_str()).object();
+    QString preload = obj["preload"].toString();
+
+    if (preload == "full")
+        return 3;
+    if (preload == "partial" || obj["launchedHidden"].toBool())
+        return 2;
+    if (preload == "minimal")
+        return 1;
+    return 0;
+}
+
+static int preloadPriority(WebAppBase::PreloadState state)
+{
+    switch (state) {
+    case WebAppBase::FULL_PRELOAD:
+        return 3;
+    case WebAppBase::PARTIAL_PRELOAD:
+        return 2;
+    case WebAppBase::MINIMAL_PRELOAD:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static bool isHiddenApp(WebAppBase* app)
+{
+    if (!app->page() || app->isClosing() || app == WebAppManager::instance()->getContainerApp())
+        return false;
+
+    return app->preloadState() != WebAppBase::NONE_PRELOAD || app->getHiddenWindow();
+}
+
+static const char* decisionName(PreloadAdmission::Decision decision)
+{
+    switch (decision) {
+    case PreloadAdmission::Defer:
+        return "defer";
+    case PreloadAdmission::Reject:
+        return "reject";
+    default:
+        return "admit";
+    }
+}
+
+PreloadAdmission::PreloadAdmission()
+    : m_level(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+{
+}
+
+PreloadAdmission::Decision PreloadAdmission::admit(const QString& appId, const std::string& appDescString,
+    const std::string& params, const std::string& launchingAppId, const std::string& instanceId)
+{
+    // The newest request for an app replaces the one still waiting
+    cancelDeferred(appId);
+
+    int priority = preloadPriority(params);
+    if (!priority || !WebAppManager::instance()->config()->getPreloadMemoryBudget())
+        return Admit;
+
+    Decision decision = decide(appId, priority, true);
+    if (decision == Defer && m_deferredLaunches.size() >= kMaxDeferredLaunches)
+        decision = Reject;
+
+    if (decision == Admit)
+        m_admitTimeMap[appId] = g_get_monotonic_time();
+    else if (decision == Defer)
+        defer(appId, appDescString, params, launchingAppId, instanceId);
+
+    LOG_INFO(MSGID_PRELOAD_ADMISSION, 4, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKFV("PRIORITY", "%d", priority),
+        PMLOGKS("DECISION", decisionName(decision)),
+        PMLOGKFV("ESTIMATE_KB", "%u", estimatedMemorySize(appId)), "");
+    return decision;
+}
+
+PreloadAdmission::Decision PreloadAdmission::decide(const QString& appId, int priority, bool evict)
+{
+    if (m_level == webos::WebViewBase::MEMORY_PRESSURE_CRITICAL)
+        return Reject;
+
+    uint32_t budget = WebAppManager::instance()->config()->getPreloadMemoryBudget();
+    uint32_t required = estimatedMemorySize(appId);
+    if (required > budget)
+        return Reject;
+
+    // Preloads arriving together at boot wait for the pressure to go away
+    if (m_level == webos::WebViewBase::MEMORY_PRESSURE_LOW)
+        return Defer;
+
+    uint32_t used = hiddenMemorySize(appId);
+    if (used + required <= budget || evictFor(appId, priority, used + required - budget, evict))
+        return Admit;
+
+    return Defer;
+}
+
+void PreloadAdmission::appClosed(const QString& appId)
+{
+    m_admitTimeMap.remove(appId);
+}
+
+void PreloadAdmission::preloadQueued(const QString& appId)
+{
+    if (!m_queuedAppIds.contains(appId))
+        m_queuedAppIds.append(appId);
+}
+
+void PreloadAdmission::preloadDequeued(const QString& appId)
+{
+    m_queuedAppIds.removeAll(appId);
+}
+
+void PreloadAdmission::memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level)
+{
+    m_level = level;
+}
+
+uint32_t PreloadAdmission::appMemorySize(WebAppBase* app)
+{
+    uint32_t pid = app->page()->getWebProcessPID();
+    uint32_t pssSize = pid ? WebAppManagerUtils::getProcessPss(pid) : 0;
+    if (!pssSize)
+        return estimatedMemorySize(app->appId());
+
+    // A shared renderer is split evenly between the apps it hosts
+    size_t apps = std::max(WebAppManager::instance()->runningApps(pid).size(), static_cast<size_t>(1));
+    pssSize /= apps;
+    m_measuredSizeMap[app->appId()] = pssSize;
+    return pssSize;
+}
+
+uint32_t PreloadAdmission::estimatedMemorySize(const QString& appId) const
+{
+    QMap<QString, uint32_t>::const_iterator it = m_measuredSizeMap.find(appId);
+    if (it != m_measuredSizeMap.end())
+        return it.value();
+
+    return WebAppManager::instance()->config()->getPreloadMemoryEstimate();
+}
+
+uint32_t PreloadAdmission::hiddenMemorySize(const QString& exceptAppId)
+{
+    uint32_t size = 0;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (app && app->appId() != exceptAppId && isHiddenApp(app))
+            size += appMemorySize(app);
+    }
+    for (int i = 0; i < m_queuedAppIds.size(); i++) {
+        if (m_queuedAppIds[i] != exceptAppId)
+            size += estimatedMemorySize(m_queuedAppIds[i]);
+    }
+    return size;
+}
+
+bool PreloadAdmission::evictFor(const QString& appId, int priority, uint32_t required, bool evict)
+{
+    // Only preloads the user has never seen, of a lower priority than the new one
+    std::vector<std::pair<qint64, WebAppBase*> > victims;
+    std::list<const WebAppBase*> apps = WebAppManager::instance()->runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = WebAppManager::instance()->findAppById((*it)->appId());
+        if (!app || app->appId() == appId || !isHiddenApp(app) || app->isActivated())
+            continue;
+
+        int victimPriority = preloadPriority(app->preloadState());
+        if (!victimPriority || victimPriority >= priority)
+            continue;
+
+        victims.push_back(std::make_pair(m_admitTimeMap.value(app->appId(), 0), app));
+    }
+    std::stable_sort(victims.begin(), victims.end(), [](const std::pair<qint64, WebAppBase*>& a, const std::pair<qint64, WebAppBase*>& b) {
+        return a.first < b.first;
+    });
+
+    uint32_t freed = 0;
+    size_t count = 0;
+    while (count < victims.size() && freed < required)
+        freed += appMemorySize(victims[count++].second);
+
+    if (freed < required)
+        return false;
+
+    if (!evict)
+        return true;
+
+    for (size_t i = 0; i < count; i++) {
+        WebAppBase* app = victims[i].second;
+        LOG_INFO(MSGID_PRELOAD_ADMISSION, 2, PMLOGKS("APP_ID", qPrintable(app->appId())),
+            PMLOGKS("FOR_APP_ID", qPrintable(appId)), "Evict preloaded app");
+        m_admitTimeMap.remove(app->appId());
+        WebAppManager::instance()->forceCloseAppInternal(app);
+    }
+    return true;
+}
+
+void PreloadAdmission::defer(const QString& appId, const std::string& appDescString,
+    const std::string& params, const std::string& launchingAppId, const std::string& instanceId)
+{
+    DeferredLaunch launch;
+    launch.appId = appId;
+    launch.appDescString = appDescString;
+    launch.params = params;
+    launch.launchingAppId = launchingAppId;
+    launch.instanceId = instanceId;
+    launch.deferTime = g_get_monotonic_time();
+    m_deferredLaunches.push_back(launch);
+
+    if (!m_retryTimer.isRunning())
+        m_retryTimer.start(kRetryIntervalMs, this, &PreloadAdmission::retryTimeout);
+}
+
+bool PreloadAdmission::cancelDeferred(const QString& appId)
+{
+    for (auto it = m_deferredLaunches.begin(); it != m_deferredLaunches.end(); ++it) {
+        if (it->appId == appId) {
+            m_deferredLaunches.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PreloadAdmission::retryTimeout()
+{
+    qint64 now = g_get_monotonic_time();
+    bool expired = false;
+    while (!m_deferredLaunches.empty() && now - m_deferredLaunches.front().deferTime > kDeferTimeoutUs) {
+        LOG_INFO(MSGID_PRELOAD_ADMISSION, 1, PMLOGKS("APP_ID", qPrintable(m_deferredLaunches.front().appId)),
+            "Deferred preload expired");
+        m_deferredLaunches.pop_front();
+        expired = true;
+    }
+
+    // SAM holds the instance ids of expired preloads, the running app list drops them
+    if (expired)
+        WebAppManager::instance()->postRunningAppList();
+
+    if (m_deferredLaunches.empty()) {
+        m_retryTimer.stop();
+        return;
+    }
+
+    // One preload per tick so a backlog does not land all at once
+    DeferredLaunch launch = m_deferredLaunches.front();
+    if (decide(launch.appId, preloadPriority(launch.params), false) != Admit)
+        return;
+
+    m_deferredLaunches.pop_front();
+    WebAppManager::instance()->launchDeferredPreload(launch.appId, launch.appDescString, launch.params,
+        launch.launchingAppId, launch.instanceId);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PRELOADADMISSION_H
+#define PRELOADADMISSION_H
+
+#include <list>
+#include <string>
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "Timer.h"
+
+#include "webos/webview_base.h"
+
+class WebAppBase;
+
+// Keeps hidden and preloaded apps within WAM_PRELOAD_MEMORY_BUDGET_IN_MB.
+// A preload that does not fit evicts the least recently launched preloads of
+// a lower priority, otherwise it is deferred until memory allows or rejected.
+class PreloadAdmission {
+public:
+    enum Decision {
+        Admit = 0,
+        Defer,
+        Reject
+    };
+
+    PreloadAdmission();
+    ~PreloadAdmission() {}
+
+    // A deferred preload keeps instanceId, it is started under it once memory allows
+    Decision admit(const QString& appId, const std::string& appDescString,
+        const std::string& params, const std::string& launchingAppId, const std::string& instanceId);
+    bool cancelDeferred(const QString& appId);
+    void appClosed(const QString& appId);
+    // Queued preloads are not running yet but already count against the budget
+    void preloadQueued(const QString& appId);
+    void preloadDequeued(const QString& appId);
+    void memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level);
+
+private:
+    Decision decide(const QString& appId, int priority, bool evict);
+    uint32_t appMemorySize(WebAppBase* app);
+    uint32_t estimatedMemorySize(const QString& appId) const;
+    uint32_t hiddenMemorySize(const QString& exceptAppId);
+    bool evictFor(const QString& appId, int priority, uint32_t required, bool evict);
+    void defer(const QString& appId, const std::string& appDescString,
+        const std::string& params, const std::string& launchingAppId, const std::string& instanceId);
+    void retryTimeout();
+
+    class DeferredLaunch {
+    public:
+        QString appId;
+        std::string appDescString;
+        std::string params;
+        std::string launchingAppId;
+        std::string instanceId;
+        qint64 deferTime; // monotonic usecs
+    };
+    std::list<DeferredLaunch> m_deferredLaunches;
+
+    // Launch time of admitted preloads, the oldest is evicted first
+    QMap<QString, qint64> m_admitTimeMap;
+    // Preloads admitted into the LaunchScheduler queue and not yet dispatched
+    QStringList m_queuedAppIds;
+    // Last measured share of renderer PSS in KB, kept after the app is closed
+    QMap<QString, uint32_t> m_measuredSizeMap;
+
+    webos::WebViewBase::MemoryPressureLevel m_level;
+    RepeatingTimer<PreloadAdmission> m_retryTimer;
+};
+
+#endif /* PRELOADADMISSION_H */
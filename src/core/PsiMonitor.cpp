@@ -0,0 +1,222 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PsiMonitor.h"
+
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <glib-unix.h>
+#include <string.h>
+#include <unistd.h>
+
+static const int kReleaseCheckIntervalMs = 1000;
+
+static gboolean psiTriggerCallback(gint fd, GIOCondition condition, gpointer data)
+{
+    PsiMonitor* monitor = static_cast<PsiMonitor*>(data);
+    if (condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL)) {
+        monitor->triggerFailed(fd);
+        return G_SOURCE_REMOVE;
+    }
+
+    // PSI trigger fds always poll readable, only G_IO_PRI means the trigger fired
+    if (condition & G_IO_PRI)
+        monitor->triggerFired(fd);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean fakeTriggerCallback(gint fd, GIOCondition condition, gpointer data)
+{
+    PsiMonitor* monitor = static_cast<PsiMonitor*>(data);
+    if (condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL)) {
+        monitor->triggerFailed(fd);
+        return G_SOURCE_REMOVE;
+    }
+
+    // Drain the fd so it only fires again on the next write
+    char buffer[128];
+    while (read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+
+    monitor->triggerFired(fd);
+    return G_SOURCE_CONTINUE;
+}
+
+PsiMonitor::PsiMonitor()
+    : m_level(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_lastLowEvent(0)
+    , m_lastCriticalEvent(0)
+{
+}
+
+PsiMonitor::~PsiMonitor()
+{
+    Q_FOREACH (const Trigger& trigger, m_triggers) {
+        g_source_remove(trigger.sourceId);
+        close(trigger.fd);
+    }
+}
+
+int PsiMonitor::openTrigger(const QString& path, const char* type, uint32_t stall, uint32_t window)
+{
+    int fd = open(qPrintable(path), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd == -1)
+        return -1;
+
+    // The kernel wants the trigger with its terminating NUL, stall and window in usecs
+    QByteArray trigger = QByteArray(type) + ' ' + QByteArray::number(stall * 1000) + ' ' + QByteArray::number(window * 1000);
+    if (write(fd, trigger.constData(), trigger.size() + 1) == -1) {
+        LOG_WARNING(MSGID_PSI_MONITOR, 2, PMLOGKS("TRIGGER", trigger.constData()), PMLOGKS("ERROR", strerror(errno)), "Fail to set PSI trigger");
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+void PsiMonitor::start()
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->isPsiMonitorEnabled() || isRunning())
+        return;
+
+    // "some" stalls mean part of the work waits on memory, "full" means all of it does
+    QString path = config->getPsiMemoryPath();
+    uint32_t window = config->getPsiWindow();
+    int lowFd = openTrigger(path, "some", config->getPsiLowStall(), window);
+    int criticalFd = openTrigger(path, "full", config->getPsiCriticalStall(), window);
+    if (lowFd == -1 || criticalFd == -1) {
+        if (lowFd != -1)
+            close(lowFd);
+        if (criticalFd != -1)
+            close(criticalFd);
+        LOG_WARNING(MSGID_PSI_MONITOR, 1, PMLOGKS("PATH", qPrintable(path)), "No PSI, memory pressure comes from memorymanager");
+        return;
+    }
+
+    watchPsiTrigger(lowFd, webos::WebViewBase::MEMORY_PRESSURE_LOW);
+    watchPsiTrigger(criticalFd, webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    LOG_INFO(MSGID_PSI_MONITOR, 1, PMLOGKS("PATH", qPrintable(path)), "Memory pressure comes from PSI");
+}
+
+bool PsiMonitor::watchTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level)
+{
+    // Draining a readable fake trigger must not block the main loop
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    return addTrigger(fd, level, static_cast<GIOCondition>(G_IO_PRI | G_IO_IN | G_IO_ERR | G_IO_HUP), fakeTriggerCallback);
+}
+
+bool PsiMonitor::watchPsiTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level)
+{
+    return addTrigger(fd, level, static_cast<GIOCondition>(G_IO_PRI | G_IO_ERR | G_IO_HUP), psiTriggerCallback);
+}
+
+bool PsiMonitor::addTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level, GIOCondition condition, GUnixFDSourceFunc callback)
+{
+    Trigger trigger(fd, level);
+    trigger.sourceId = g_unix_fd_add(fd, condition, callback, this);
+    if (!trigger.sourceId)
+        return false;
+
+    m_triggers.append(trigger);
+    return true;
+}
+
+void PsiMonitor::triggerFailed(int fd)
+{
+    // The GSource is removed by returning G_SOURCE_REMOVE from its callback
+    for (int i = 0; i < m_triggers.size(); i++) {
+        if (m_triggers.at(i).fd != fd)
+            continue;
+
+        LOG_WARNING(MSGID_PSI_MONITOR, 1, PMLOGKFV("FD", "%d", fd), "PSI trigger closed");
+        close(fd);
+        m_triggers.removeAt(i);
+        break;
+    }
+
+    if (!isRunning())
+        setLevel(webos::WebViewBase::MEMORY_PRESSURE_NONE);
+}
+
+int PsiMonitor::severity(webos::WebViewBase::MemoryPressureLevel level)
+{
+    switch (level) {
+    case webos::WebViewBase::MEMORY_PRESSURE_CRITICAL:
+        return 2;
+    case webos::WebViewBase::MEMORY_PRESSURE_LOW:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+void PsiMonitor::triggerFired(int fd)
+{
+    webos::WebViewBase::MemoryPressureLevel level = webos::WebViewBase::MEMORY_PRESSURE_NONE;
+    for (int i = 0; i < m_triggers.size(); i++) {
+        if (m_triggers.at(i).fd == fd)
+            level = m_triggers.at(i).level;
+    }
+
+    qint64 now = g_get_monotonic_time();
+    if (level == webos::WebViewBase::MEMORY_PRESSURE_CRITICAL)
+        m_lastCriticalEvent = now;
+    else if (level == webos::WebViewBase::MEMORY_PRESSURE_LOW)
+        m_lastLowEvent = now;
+
+    // Rising is immediate, falling waits for releaseTimeout
+    if (severity(level) > severity(m_level))
+        setLevel(level);
+}
+
+void PsiMonitor::releaseTimeout()
+{
+    qint64 release = static_cast<qint64>(WebAppManager::instance()->config()->getPsiReleaseTime()) * 1000;
+    qint64 now = g_get_monotonic_time();
+
+    webos::WebViewBase::MemoryPressureLevel level = webos::WebViewBase::MEMORY_PRESSURE_NONE;
+    if (now - m_lastCriticalEvent < release)
+        level = webos::WebViewBase::MEMORY_PRESSURE_CRITICAL;
+    else if (now - m_lastLowEvent < release)
+        level = webos::WebViewBase::MEMORY_PRESSURE_LOW;
+
+    if (severity(level) < severity(m_level))
+        setLevel(level);
+}
+
+void PsiMonitor::setLevel(webos::WebViewBase::MemoryPressureLevel level)
+{
+    if (level == m_level)
+        return;
+
+    m_level = level;
+    if (m_level == webos::WebViewBase::MEMORY_PRESSURE_NONE) {
+        if (m_releaseTimer.isRunning())
+            m_releaseTimer.stop();
+    } else if (!m_releaseTimer.isRunning()) {
+        m_releaseTimer.start(kReleaseCheckIntervalMs, this, &PsiMonitor::releaseTimeout);
+    }
+
+    LOG_INFO(MSGID_PSI_MONITOR, 1, PMLOGKFV("LEVEL", "%d", static_cast<int>(level)), "Memory pressure changed");
+    WebAppManager::instance()->notifyMemoryPressure(level);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PSIMONITOR_H
+#define PSIMONITOR_H
+
+#include <QList>
+#include <QString>
+
+#include "Timer.h"
+
+#include "webos/webview_base.h"
+
+#include <glib-unix.h>
+
+// Watches PSI memory triggers on the main loop and feeds the resulting level
+// to WebAppManager::notifyMemoryPressure. A level is entered on the first
+// trigger and left only after its triggers stay quiet for the release time.
+class PsiMonitor {
+public:
+    PsiMonitor();
+    ~PsiMonitor();
+
+    void start();
+    bool isRunning() const { return !m_triggers.isEmpty(); }
+
+    // Any fd becoming readable or priority-readable counts as a trigger,
+    // which lets a pipe stand in for the kernel. The monitor owns the fd.
+    // Kernel trigger fds are watched for G_IO_PRI only, see start().
+    bool watchTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level);
+    void triggerFired(int fd);
+    void triggerFailed(int fd);
+
+private:
+    static int severity(webos::WebViewBase::MemoryPressureLevel level);
+    int openTrigger(const QString& path, const char* type, uint32_t stall, uint32_t window);
+    bool watchPsiTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level);
+    bool addTrigger(int fd, webos::WebViewBase::MemoryPressureLevel level, GIOCondition condition, GUnixFDSourceFunc callback);
+    void setLevel(webos::WebViewBase::MemoryPressureLevel level);
+    void releaseTimeout();
+
+    class Trigger {
+    public:
+        Trigger(int f = -1, webos::WebViewBase::MemoryPressureLevel l = webos::WebViewBase::MEMORY_PRESSURE_NONE)
+            : fd(f)
+            , sourceId(0)
+            , level(l)
+        {
+        }
+
+        int fd;
+        unsigned int sourceId;
+        webos::WebViewBase::MemoryPressureLevel level;
+    };
+    QList<Trigger> m_triggers;
+
+    webos::WebViewBase::MemoryPressureLevel m_level;
+    qint64 m_lastLowEvent; // monotonic usecs
+    qint64 m_lastCriticalEvent; // monotonic usecs
+    RepeatingTimer<PsiMonitor> m_releaseTimer;
+};
+
+#endif /* PSIMONITOR_H */
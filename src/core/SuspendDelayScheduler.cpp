@@ -0,0 +1,136 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SuspendDelayScheduler.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+
+#include <glib.h>
+
+// Samples needed before the learned dwell time is trusted
+static const uint32_t kMinDwellSamples = 3;
+
+SuspendDelayScheduler::SuspendDelayScheduler()
+    : m_level(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_savedPairs(0)
+    , m_addedPairs(0)
+{
+}
+
+int SuspendDelayScheduler::adaptiveDelay(const QString& appId, bool mediaCapture) const
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    int globalDelay = config->getSuspendDelayTime();
+    if (!config->isAdaptiveSuspendDelayEnabled())
+        return globalDelay;
+
+    int minDelay = std::min(globalDelay, static_cast<int>(config->getSuspendDelayMin()));
+    int maxDelay = std::max(globalDelay, static_cast<int>(config->getSuspendDelayMax()));
+
+    // Memory is short, do not keep background pages running
+    if (m_level == webos::WebViewBase::MEMORY_PRESSURE_CRITICAL)
+        return minDelay;
+
+    int delay = globalDelay;
+    QMap<QString, DwellInfo>::const_iterator it = m_dwellInfoMap.find(appId);
+    if (it != m_dwellInfoMap.end() && it.value().sampleCount >= kMinDwellSamples) {
+        int averageDwell = it.value().averageDwell;
+        if (averageDwell * 3 / 2 <= maxDelay) {
+            // Usually back soon, outlast the typical dwell to skip a suspend/resume pair
+            delay = std::max(averageDwell * 3 / 2, globalDelay);
+        } else {
+            // Usually stays in background, stop it right away
+            delay = minDelay;
+        }
+    }
+
+    // Pages with camera or microphone are expensive to resume
+    if (mediaCapture)
+        delay = std::max(delay, globalDelay);
+
+    if (m_level == webos::WebViewBase::MEMORY_PRESSURE_LOW)
+        delay = std::max(delay / 2, minDelay);
+
+    return delay;
+}
+
+int SuspendDelayScheduler::suspendDelay(const QString& appId, bool mediaCapture)
+{
+    // Low-power mode quiesces background pages right away
+    int delay = WebAppManager::instance()->isLowPowerMode() ? 0 : adaptiveDelay(appId, mediaCapture);
+
+    DwellInfo& info = m_dwellInfoMap[appId];
+    info.backgroundTime = g_get_monotonic_time();
+    info.scheduledDelay = delay;
+    return delay;
+}
+
+void SuspendDelayScheduler::appResumed(const QString& appId)
+{
+    QMap<QString, DwellInfo>::iterator it = m_dwellInfoMap.find(appId);
+    if (it == m_dwellInfoMap.end() || !it.value().backgroundTime)
+        return;
+
+    DwellInfo& info = it.value();
+    int dwell = static_cast<int>((g_get_monotonic_time() - info.backgroundTime) / 1000);
+    info.backgroundTime = 0;
+
+    // Exponential moving average, weighting the latest dwell by 1/4
+    if (!info.sampleCount)
+        info.averageDwell = dwell;
+    else
+        info.averageDwell += (dwell - info.averageDwell) / 4;
+    info.sampleCount++;
+
+    int globalDelay = WebAppManager::instance()->config()->getSuspendDelayTime();
+    if (dwell < info.scheduledDelay && dwell >= globalDelay)
+        m_savedPairs++;
+    else if (dwell >= info.scheduledDelay && dwell < globalDelay)
+        m_addedPairs++;
+}
+
+void SuspendDelayScheduler::memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level)
+{
+    m_level = level;
+}
+
+QJsonObject SuspendDelayScheduler::getSuspendDelayStats() const
+{
+    QJsonObject stats;
+    QJsonArray apps;
+
+    for (QMap<QString, DwellInfo>::const_iterator it = m_dwellInfoMap.begin(); it != m_dwellInfoMap.end(); ++it) {
+        QJsonObject app;
+        app["id"] = it.key();
+        app["averageDwellInMs"] = it.value().averageDwell;
+        app["sampleCount"] = static_cast<int>(it.value().sampleCount);
+        app["lastDelayInMs"] = it.value().scheduledDelay;
+        app["inBackground"] = it.value().backgroundTime != 0;
+        apps.append(app);
+    }
+
+    stats["apps"] = apps;
+    stats["globalDelayInMs"] = WebAppManager::instance()->config()->getSuspendDelayTime();
+    stats["savedPairs"] = static_cast<int>(m_savedPairs);
+    stats["addedPairs"] = static_cast<int>(m_addedPairs);
+    return stats;
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SUSPENDDELAYSCHEDULER_H
+#define SUSPENDDELAYSCHEDULER_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+
+#include "webos/webview_base.h"
+
+// Picks the DOM suspend delay of each app from how long it usually stays
+// in background, instead of one WAM_SUSPEND_DELAY_IN_MS for every app
+class SuspendDelayScheduler {
+public:
+    SuspendDelayScheduler();
+    ~SuspendDelayScheduler() {}
+
+    // Called when the page goes to background and arms its suspend timer
+    int suspendDelay(const QString& appId, bool mediaCapture);
+    // Called when the page comes back from background
+    void appResumed(const QString& appId);
+    void memoryPressureChanged(webos::WebViewBase::MemoryPressureLevel level);
+    QJsonObject getSuspendDelayStats() const;
+
+private:
+    int adaptiveDelay(const QString& appId, bool mediaCapture) const;
+
+    class DwellInfo {
+    public:
+        DwellInfo()
+            : averageDwell(0)
+            , sampleCount(0)
+            , backgroundTime(0)
+            , scheduledDelay(0)
+        {
+        }
+
+        int averageDwell; // ms
+        uint32_t sampleCount;
+        qint64 backgroundTime; // monotonic usecs, 0 while in foreground
+        int scheduledDelay; // ms
+    };
+    QMap<QString, DwellInfo> m_dwellInfoMap;
+
+    webos::WebViewBase::MemoryPressureLevel m_level;
+    uint32_t m_savedPairs; // resumed before suspend only thanks to a longer delay
+    uint32_t m_addedPairs; // suspended and resumed only due to a shorter delay
+};
+
+#endif /* SUSPENDDELAYSCHEDULER_H */
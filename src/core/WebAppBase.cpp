@@ -25,6 +25,8 @@
 #include "WebAppManager.h"
 #include "WebPageBase.h"
 
+#include <glib.h>
+
 class WebAppBasePrivate
 {
 public:
@@ -74,6 +76,8 @@ WebAppBase::WebAppBase()
     , m_crashed(false)
     , m_hiddenWindow(false)
     , m_wasContainerApp(false)
+    , m_discarded(false)
+    , m_restoreStartTime(0)
 {
 }
 
@@ -99,7 +103,7 @@ void WebAppBase::setHiddenWindow(bool hidden)
     m_hiddenWindow = hidden;
 }
 
-bool WebAppBase::getHiddenWindow()
+bool WebAppBase::getHiddenWindow() const
 {
     return m_hiddenWindow;
 }
@@ -119,7 +123,7 @@ void WebAppBase::setKeepAlive(bool keepAlive)
     d->m_keepAlive = keepAlive;
 }
 
-bool WebAppBase::keepAlive()
+bool WebAppBase::keepAlive() const
 {
     return d->m_keepAlive;
 }
@@ -311,6 +315,41 @@ void WebAppBase::webPageLoadFinishedSlot()
     doPendingRelaunch();
 }
 
+bool WebAppBase::discard()
+{
+    if (m_discarded || !d->m_page)
+        return false;
+
+    QUrl url = d->m_page->url();
+    if (!d->m_page->discardWebView())
+        return false;
+
+    m_discardedUrl = url;
+    m_discarded = true;
+    return true;
+}
+
+void WebAppBase::restore()
+{
+    if (!m_discarded)
+        return;
+
+    LOG_INFO(MSGID_APP_RESTORE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKS("URL", qPrintable(m_discardedUrl.toString())), "");
+    m_discarded = false;
+    m_restoreStartTime = g_get_monotonic_time();
+    d->m_page->restoreWebView(m_discardedUrl, m_restoreState);
+}
+
+void WebAppBase::restoreFinished()
+{
+    if (!m_restoreStartTime)
+        return;
+
+    int restoreTime = static_cast<int>((g_get_monotonic_time() - m_restoreStartTime) / 1000);
+    m_restoreStartTime = 0;
+    WebAppManager::instance()->appRestored(appId(), restoreTime);
+}
+
 void WebAppBase::doPendingRelaunch()
 {
     if(m_inProgressRelaunchLaunchingAppId.size() || m_inProgressRelaunchParams.size()) {
@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QUrl>
 
 #include "WebAppManager.h"
 #include "WebPageObserver.h"
@@ -85,10 +86,10 @@ public:
 
     bool getCrashState();
     void setCrashState(bool state);
-    bool getHiddenWindow();
+    bool getHiddenWindow() const;
     void setWasContainerApp(bool contained);
     bool wasContainerApp() const;
-    bool keepAlive();
+    bool keepAlive() const;
     void setForceClose();
     bool forceClose();
     WebPageBase* page() const;
@@ -125,6 +126,12 @@ public:
     bool isClosing() const;
     bool isCheckLaunchTimeEnabled();
 
+    // Discarded app keeps its window and description but not its document
+    bool discard();
+    void restore();
+    bool isDiscarded() const { return m_discarded; }
+    void setRestoreState(const QString& state) { m_restoreState = state; }
+
 protected:
     virtual void doAttach() = 0;
     virtual void showWindow();
@@ -133,6 +140,7 @@ protected:
     void setActiveAppId(QString id);
     void forceCloseAppInternal();
     void closeAppInternal();
+    void restoreFinished();
 
 protected Q_SLOTS:
     virtual void webPageUrlChangedSlot();
@@ -155,5 +163,9 @@ private:
     bool m_crashed;
     bool m_hiddenWindow;
     bool m_wasContainerApp; // should be set to true if launched via container
+    bool m_discarded;
+    QUrl m_discardedUrl;
+    QString m_restoreState;
+    qint64 m_restoreStartTime;
 };
 #endif // WEBAPPBASE_H
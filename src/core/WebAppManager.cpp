@@ -22,25 +22,42 @@
 
 #include <QtCore/QJsonDocument>
 
+#include "AppEvictionManager.h"
 #include "ApplicationDescription.h"
+#include "BackgroundCpuBudget.h"
+#include "CgroupManager.h"
+#include "CloseGraceManager.h"
 #include "ContainerAppManager.h"
+#include "CrashRecoveryManager.h"
 #include "DeviceInfo.h"
+#include "DiskWriteBudget.h"
+#include "ExclusiveModeManager.h"
+#include "IdleTaskScheduler.h"
+#include "KeepAliveTrimmer.h"
+#include "LaunchBoost.h"
+#include "LaunchScheduler.h"
 #include "LogManager.h"
+#include "LowPowerManager.h"
 #include "NetworkStatusManager.h"
 #include "PlatformModuleFactory.h"
+#include "PreloadAdmission.h"
+#include "PsiMonitor.h"
 #include "ServiceSender.h"
+#include "SuspendDelayScheduler.h"
 #include "WebAppBase.h"
 #include "WebAppFactoryManager.h"
 #include "WebAppManagerConfig.h"
 #include "WebAppManagerService.h"
 #include "WebAppManagerTracer.h"
+#include "WebAppManagerUtils.h"
 #include "WebPageBase.h"
 #include "WebProcessManager.h"
 #include "WindowTypes.h"
 
 #include "webos/public/runtime.h"
 
-static const int kContinuousReloadingLimit = 3;
+// Storage of a removed app is deleted at the latest this long after removal
+static const int kDeleteStorageDataTimeoutMs = 60 * 1000;
 
 WebAppManager* WebAppManager::instance()
 {
@@ -57,7 +74,21 @@ WebAppManager::WebAppManager()
     , m_deviceInfo(0)
     , m_webAppManagerConfig(0)
     , m_networkStatusManager(new NetworkStatusManager())
-    , m_suspendDelay(0)
+    , m_crashRecoveryManager(new CrashRecoveryManager())
+    , m_appEvictionManager(new AppEvictionManager())
+    , m_closeGraceManager(new CloseGraceManager())
+    , m_suspendDelayScheduler(new SuspendDelayScheduler())
+    , m_backgroundCpuBudget(new BackgroundCpuBudget())
+    , m_cgroupManager(new CgroupManager())
+    , m_diskWriteBudget(new DiskWriteBudget())
+    , m_launchBoost(new LaunchBoost())
+    , m_psiMonitor(new PsiMonitor())
+    , m_keepAliveTrimmer(new KeepAliveTrimmer())
+    , m_preloadAdmission(new PreloadAdmission())
+    , m_launchScheduler(new LaunchScheduler())
+    , m_idleTaskScheduler(new IdleTaskScheduler())
+    , m_lowPowerManager(new LowPowerManager())
+    , m_exclusiveModeManager(new ExclusiveModeManager())
     , m_isAccessibilityEnabled(false)
 {
 }
@@ -74,6 +105,61 @@ WebAppManager::~WebAppManager()
         delete m_deviceInfo;
     if (m_networkStatusManager)
         delete m_networkStatusManager;
+    if (m_crashRecoveryManager)
+        delete m_crashRecoveryManager;
+    if (m_appEvictionManager)
+        delete m_appEvictionManager;
+    if (m_closeGraceManager)
+        delete m_closeGraceManager;
+    if (m_suspendDelayScheduler)
+        delete m_suspendDelayScheduler;
+    if (m_backgroundCpuBudget)
+        delete m_backgroundCpuBudget;
+    if (m_cgroupManager)
+        delete m_cgroupManager;
+    if (m_diskWriteBudget)
+        delete m_diskWriteBudget;
+    if (m_launchBoost)
+        delete m_launchBoost;
+    if (m_psiMonitor)
+        delete m_psiMonitor;
+    if (m_keepAliveTrimmer)
+        delete m_keepAliveTrimmer;
+    if (m_preloadAdmission)
+        delete m_preloadAdmission;
+    if (m_exclusiveModeManager)
+        delete m_exclusiveModeManager;
+    if (m_lowPowerManager)
+        delete m_lowPowerManager;
+    if (m_idleTaskScheduler)
+        delete m_idleTaskScheduler;
+    if (m_launchScheduler)
+        delete m_launchScheduler;
+}
+
+bool WebAppManager::isPsiMonitorRunning()
+{
+    return m_psiMonitor->isRunning();
+}
+
+bool WebAppManager::setPowerState(const QString& state)
+{
+    return m_lowPowerManager->setPowerState(state);
+}
+
+bool WebAppManager::isLowPowerMode()
+{
+    return m_lowPowerManager->isLowPower();
+}
+
+void WebAppManager::setExclusiveForeground(const QString& appId, bool exclusive)
+{
+    m_exclusiveModeManager->setExclusiveApp(appId, exclusive);
+}
+
+bool WebAppManager::isExclusiveMode()
+{
+    return m_exclusiveModeManager->isExclusive();
 }
 
 void WebAppManager::notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level)
@@ -81,9 +167,22 @@ void WebAppManager::notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel
     std::list<const WebAppBase*> appList = runningApps();
     for (auto it = appList.begin(); it != appList.end(); ++it) {
         const WebAppBase* app = *it;
+        if (m_webProcessManager)
+            m_webProcessManager->updateAppMemoryUsage(app->appId(), app->page()->getWebProcessPID());
         if (app->isActivated() && !app->page()->isPreload())
             app->page()->notifyMemoryPressure(level);
+        app->page()->sendMemoryPressureEvent(level);
     }
+    m_closeGraceManager->memoryPressureChanged(level);
+    m_suspendDelayScheduler->memoryPressureChanged(level);
+    m_appEvictionManager->memoryPressureChanged(level);
+    m_preloadAdmission->memoryPressureChanged(level);
+}
+
+void WebAppManager::setActiveAppId(QString id)
+{
+    m_activeAppId = id;
+    m_appEvictionManager->appActivated(id);
 }
 
 void WebAppManager::setPlatformModules(PlatformModuleFactory* factory)
@@ -110,8 +209,11 @@ void WebAppManager::quit()
 
 void WebAppManager::loadEnvironmentVariable()
 {
-    m_suspendDelay = m_webAppManagerConfig->getSuspendDelayTime();
     m_webAppManagerConfig->postInitConfiguration();
+    m_backgroundCpuBudget->start();
+    m_cgroupManager->init();
+    m_diskWriteBudget->start();
+    m_psiMonitor->start();
 
     if (m_containerAppManager)
         m_containerAppManager->setUseContainerAppOptimization(m_webAppManagerConfig->isUseSystemAppOptimization());
@@ -199,6 +301,7 @@ void WebAppManager::onLaunchContainerBasedApp(const std::string& url, QString& w
     page->setLaunchParams(args.c_str());
 
     app->setWasContainerApp(true);
+    m_appEvictionManager->appLaunched(QString::fromStdString(appId));
 
     QString launchDetail(args.c_str());
     app->configureWindow(winType);
@@ -272,6 +375,9 @@ void WebAppManager::onRelaunchApp(const std::string& instanceId, const std::stri
     if (app->instanceId() == QString::fromStdString(instanceId)
         && !obj["preload"].isString()
         && !obj["launchedHidden"].toBool()) {
+        m_cgroupManager->thawWebProcess(app->page()->getWebProcessPID());
+        if (app->isDiscarded())
+            app->restore();
         app->relaunch(args.c_str(), launchingAppId.c_str());
     } else {
         LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKFV("PID", "%d", app->page()->getWebProcessPID()), "Relaunch with preload option, ignore");
@@ -325,12 +431,19 @@ bool WebAppManager::onKillApp(const std::string& appId)
 {
     QString __appId = QString::fromStdString(appId);
     WebAppBase* app = findAppById(__appId);
+    if (!app && m_launchScheduler->cancelPreload(__appId)) {
+        m_preloadAdmission->preloadDequeued(__appId);
+        return true;
+    }
+    if (!app && m_preloadAdmission->cancelDeferred(__appId))
+        return true;
     if (!app) {
         LOG_INFO(MSGID_KILL_APP, 1, PMLOGKS("APP_ID", qPrintable(QString::fromStdString(appId))), "App doesn't exist; return");
         return false;
     }
 
-    closeAppInternal(app);
+    if (!deferCloseApp(app))
+        closeAppInternal(app);
     return true;
 }
 
@@ -400,6 +513,7 @@ WebAppBase* WebAppManager::onLaunchUrl(const std::string& url, QString winType,
     webPageAdded(page);
 
     m_appList.push_back(app);
+    m_appEvictionManager->appLaunched(app->appId());
 
     if (m_appVersion.find(appDesc->id()) != m_appVersion.end()) {
       if (m_appVersion[appDesc->id()] != appDesc->version()) {
@@ -438,6 +552,17 @@ void WebAppManager::removeClosingAppList(const QString& appId)
    m_closingAppList.remove(appId);
 }
 
+bool WebAppManager::deferCloseApp(WebAppBase* app)
+{
+    if (!m_closeGraceManager->deferClose(app))
+        return false;
+
+    // Looks closed to everyone until it is reopened or the close finishes
+    m_appList.remove(app);
+    postRunningAppList();
+    return true;
+}
+
 void WebAppManager::closeAppInternal(WebAppBase* app, bool ignoreCleanResource)
 {
     WebPageBase* page = app->page();
@@ -449,11 +574,25 @@ void WebAppManager::closeAppInternal(WebAppBase* app, bool ignoreCleanResource)
     LOG_INFO(MSGID_CLOSE_APP_INTERNAL, 2, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKFV("PID", "%d", app->page()->getWebProcessPID()), "");
 
     std::string type = app->getAppDescription()->defaultWindowType();
+    if (m_webProcessManager) {
+        m_webProcessManager->updateAppMemoryUsage(app->appId(), app->page()->getWebProcessPID());
+        m_webProcessManager->appClosed(app->appId());
+    }
     appDeleted(app);
     webPageRemoved(app->page());
     removeWebAppFromWebProcessInfoMap(app->appId());
     postRunningAppList();
-    m_lastCrashedAppIds = QMap<QString, int>();
+    m_crashRecoveryManager->appClosed(app->appId());
+    m_appEvictionManager->appClosed(app->appId());
+    m_backgroundCpuBudget->appClosed(app->appId());
+    m_diskWriteBudget->appClosed(app->appId());
+    m_keepAliveTrimmer->appClosed(app->appId());
+    m_preloadAdmission->appClosed(app->appId());
+    m_launchScheduler->launchFinished(app->appId());
+    m_exclusiveModeManager->appDeactivated(app->appId());
+    m_cgroupManager->appClosed(app->appId(), app->page()->getWebProcessPID());
+    if (m_webProcessManager)
+        m_webProcessManager->updateWebProcessPriority(app->page()->getWebProcessPID());
 
     // Set m_isClosing flag first, this flag will be checked in web page suspending
     page->setClosing(true);
@@ -484,6 +623,8 @@ void WebAppManager::closeAppInternal(WebAppBase* app, bool ignoreCleanResource)
 
 bool WebAppManager::closeAllApps(uint32_t pid)
 {
+    m_closeGraceManager->finishAll(pid);
+
     AppList runningApps;
 
     for (AppList::iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
@@ -644,30 +785,23 @@ bool WebAppManager::processCrashed(QString appId) {
         return true;
     }
 
+    // Held apps are out of m_appList, their page must not be force deleted
+    if (m_closeGraceManager->appCrashed(appId))
+        return true;
+
     WebAppBase* app = findAppById(appId);
     if (!app)
         return false;
 
-    if (app->isWindowed()) {
-        if (app->isActivated()) {
-            int count = m_lastCrashedAppIds[app->appId()];
-            m_lastCrashedAppIds[app->appId()] = count + 1;
-
-            int reloadingLimit = app->isNormal() ? kContinuousReloadingLimit-1 : kContinuousReloadingLimit;
+    // A reclaimed renderer did not crash, the app is only reloaded when shown again
+    if (m_webProcessManager && !m_webProcessManager->appCrashed(appId)) {
+        app->setCrashState(true);
+        return true;
+    }
 
-            if (m_lastCrashedAppIds[app->appId()] >= reloadingLimit) {
-                LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InForeground", "true"), PMLOGKS("Reloading limit", "Close app"),  "");
-                closeAppInternal(app, true);
-            }
-            else {
-                LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InForeground", "true"), PMLOGKS("Reloading limit", "OK; Reload default page"),  "");
-                app->page()->reloadDefaultPage();
-            }
-        }
-        else if (app->isMinimized()) {
-            LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InBackground", "Will be Reloaded in Relaunch"),  "");
-            app->setCrashState(true);
-        }
+    if (app->isWindowed() && (app->isActivated() || app->isMinimized())) {
+        if (!m_crashRecoveryManager->appCrashed(app))
+            closeAppInternal(app, true);
     }
     return true;
 }
@@ -706,7 +840,8 @@ void WebAppManager::setForceCloseApp(QString appId)
 
 void WebAppManager::requestKillWebProcess(uint32_t pid)
 {
-    // Deprecated (2016-0401)
+    if (m_webProcessManager)
+        m_webProcessManager->requestKillWebProcess(pid);
 }
 
 bool WebAppManager::shouldLaunchContainerAppOnDemand()
@@ -728,9 +863,41 @@ uint32_t WebAppManager::getContainerAppProxyID()
     return proxyID;
 }
 
+// Keyed by identifier so a pending delete can be cancelled for one app
+static QString deleteStorageDataTaskName(const QString& identifier)
+{
+    return QStringLiteral("deleteStorageData:") + identifier;
+}
+
+class DeleteStorageDataTask : public IdleTask {
+public:
+    DeleteStorageDataTask(const QString& identifier)
+        : IdleTask(deleteStorageDataTaskName(identifier))
+        , m_identifier(identifier)
+    {
+    }
+
+    bool run(qint64 deadline) override
+    {
+        WebAppManager::instance()->deleteStorageDataNow(m_identifier);
+        return true;
+    }
+
+private:
+    QString m_identifier;
+};
+
 void WebAppManager::deleteStorageData(const QString& identifier)
 {
+    // Storage of removed apps is not urgent, it waits for an idle period
+    m_idleTaskScheduler->postTask(new DeleteStorageDataTask(identifier), kDeleteStorageDataTimeoutMs);
+}
+
+void WebAppManager::deleteStorageDataNow(const QString& identifier)
+{
+    int ioPriority = lowerIoPriority();
     m_webProcessManager->deleteStorageData(identifier);
+    restoreIoPriority(ioPriority);
 }
 
 void WebAppManager::killCustomPluginProcess(const QString &basePath)
@@ -759,8 +926,21 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
     std::string instanceId = "";
     std::string url = desc->entryPoint();
     QString winType = windowTypeFromString(desc->defaultWindowType());
+    QString appId = QString::fromStdString(desc->id());
+    LaunchScheduler::LaunchClass launchClass = LaunchScheduler::launchClass(winType, params);
     errMsg.erase();
 
+    // The container is warmed up, not shown
+    if (!isContainerApp(url))
+        m_launchBoost->begin(appId, params);
+
+    // A newer request for the app supersedes a preload still waiting in the queue
+    if (launchClass != LaunchScheduler::ClassPreload && m_launchScheduler->cancelPreload(appId))
+        m_preloadAdmission->preloadDequeued(appId);
+
+    // The app was reinstalled, the pending delete would wipe the new install's storage
+    m_idleTaskScheduler->cancelTasks(deleteStorageDataTaskName(appId));
+
     // Check if app is container itself, it shouldn't be relaunched like normal app
     if (isContainerApp(url)) {
         if (!isRunningApp(desc->id(), instanceId))
@@ -771,8 +951,20 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
         }
         delete desc;
     }
+    // Check if app was closed within the grace period
+    else if (WebAppBase* app = m_closeGraceManager->takeApp(QString::fromStdString(desc->id()))) {
+        m_appList.push_back(app);
+        postRunningAppList();
+        instanceId = app->instanceId().toStdString();
+        if (launchClass != LaunchScheduler::ClassPreload)
+            m_launchScheduler->launchStarted(appId, LaunchScheduler::ClassRelaunch);
+        onRelaunchApp(instanceId, desc->id().c_str(), params.c_str(), launchingAppId.c_str());
+        delete desc;
+    }
     // Check if app is already running
     else if (isRunningApp(desc->id(), instanceId)) {
+        if (launchClass != LaunchScheduler::ClassPreload)
+            m_launchScheduler->launchStarted(appId, LaunchScheduler::ClassRelaunch);
         onRelaunchApp(instanceId, desc->id().c_str(), params.c_str(), launchingAppId.c_str());
         delete desc;
     }
@@ -782,9 +974,11 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
             delete desc;
             errCode = ERR_CODE_LAUNCHAPP_INVALID_TRUSTLEVEL;
             errMsg = err_invalidTrustLevel;
+            m_launchBoost->cancel(appId);
             return std::string();
         }
         instanceId = m_containerAppManager->getContainerApp()->instanceId().toStdString();
+        m_launchScheduler->launchStarted(appId, launchClass);
         onLaunchContainerBasedApp(url.c_str(),
             winType,
             desc,
@@ -792,9 +986,48 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
     }
     // Run as a normal app
     else {
+        // Preloads would take memory from the app in exclusive mode
+        if (launchClass == LaunchScheduler::ClassPreload && m_exclusiveModeManager->refusePreload(appId)) {
+            delete desc;
+            errCode = ERR_CODE_LAUNCHAPP_PRELOAD_REFUSED;
+            errMsg = err_preloadRefused;
+            m_launchBoost->cancel(appId);
+            return std::string();
+        }
+
         instanceId = generateInstanceId();
+        PreloadAdmission::Decision decision = m_preloadAdmission->admit(appId, appDescString, params, launchingAppId, instanceId);
+        if (decision == PreloadAdmission::Reject) {
+            delete desc;
+            errCode = ERR_CODE_LAUNCHAPP_PRELOAD_REJECTED;
+            errMsg = err_preloadRejected;
+            m_launchBoost->cancel(appId);
+            return std::string();
+        }
+        // A deferred preload is started under this instance id once memory allows
+        if (decision == PreloadAdmission::Defer) {
+            delete desc;
+            m_launchBoost->cancel(appId);
+            return instanceId;
+        }
+
+        // Preloads wait for higher classes and are staggered during boot,
+        // the instance id handed out now is the one they are started with
+        if (launchClass == LaunchScheduler::ClassPreload) {
+            if (m_launchScheduler->queuePreload(appId, appDescString, params, launchingAppId, instanceId)) {
+                m_preloadAdmission->preloadQueued(appId);
+                delete desc;
+                return instanceId;
+            }
+        } else {
+            m_launchScheduler->recordQueueDelay(launchClass, 0);
+        }
+
+        m_launchScheduler->launchStarted(appId, launchClass);
         if (!onLaunchUrl(url, winType, desc, instanceId, params, launchingAppId, errCode, errMsg)) {
             delete desc;
+            m_launchBoost->cancel(appId);
+            m_launchScheduler->launchFinished(appId);
             return std::string();
         }
     }
@@ -802,6 +1035,64 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
     return instanceId;
 }
 
+void WebAppManager::launchQueuedPreload(const std::string& appDescString, const std::string& params,
+        const std::string& launchingAppId, const std::string& instanceId)
+{
+    ApplicationDescription* desc = ApplicationDescription::fromJsonString(appDescString.c_str());
+    if (!desc)
+        return;
+
+    QString appId = QString::fromStdString(desc->id());
+    m_preloadAdmission->preloadDequeued(appId);
+
+    std::string runningInstanceId;
+    if (isRunningApp(desc->id(), runningInstanceId)) {
+        delete desc;
+        return;
+    }
+
+    // Memory and exclusive mode may have changed while the preload was queued.
+    // SAM already holds its instance id, the running app list tells it the app is gone
+    if (m_exclusiveModeManager->refusePreload(appId)) {
+        LOG_INFO(MSGID_LAUNCH_SCHEDULER, 1, PMLOGKS("APP_ID", qPrintable(appId)), "Queued preload refused in exclusive mode");
+        delete desc;
+        postRunningAppList();
+        return;
+    }
+
+    // A deferred preload is retried by PreloadAdmission under the same instance id
+    PreloadAdmission::Decision decision = m_preloadAdmission->admit(appId, appDescString, params, launchingAppId, instanceId);
+    if (decision != PreloadAdmission::Admit) {
+        LOG_INFO(MSGID_LAUNCH_SCHEDULER, 1, PMLOGKS("APP_ID", qPrintable(appId)), "Queued preload not admitted");
+        delete desc;
+        if (decision == PreloadAdmission::Reject)
+            postRunningAppList();
+        return;
+    }
+
+    int errCode = 0;
+    std::string errMsg;
+    m_launchScheduler->launchStarted(appId, LaunchScheduler::ClassPreload);
+    if (!onLaunchUrl(desc->entryPoint(), windowTypeFromString(desc->defaultWindowType()), desc, instanceId, params, launchingAppId, errCode, errMsg)) {
+        LOG_WARNING(MSGID_LAUNCH_SCHEDULER, 2, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("ERROR", errMsg.c_str()), "Failed to launch queued preload");
+        delete desc;
+        m_launchScheduler->launchFinished(appId);
+        postRunningAppList();
+    }
+}
+
+void WebAppManager::launchDeferredPreload(const QString& appId, const std::string& appDescString,
+        const std::string& params, const std::string& launchingAppId, const std::string& instanceId)
+{
+    // Admitted preloads still wait for higher classes, then admission runs again at dispatch
+    if (m_launchScheduler->queuePreload(appId, appDescString, params, launchingAppId, instanceId)) {
+        m_preloadAdmission->preloadQueued(appId);
+        return;
+    }
+
+    launchQueuedPreload(appDescString, params, launchingAppId, instanceId);
+}
+
 bool WebAppManager::isContainerApp(const std::string& url)
 {
     if (!m_containerAppManager)
@@ -842,6 +1133,10 @@ bool WebAppManager::isContainerBasedApp(ApplicationDescription* containerBasedAp
     if (containerBasedAppDesc->containerJS().size() == 0)
         return false;
 
+    // Apps in the container share its renderer, a quarantined app gets a web view of its own
+    if (m_webProcessManager && m_webProcessManager->isQuarantinedApp(QString::fromStdString(containerBasedAppDesc->id())))
+        return false;
+
     ApplicationDescription* containerAppDesc = m_containerAppManager->getContainerApp()->getAppDescription();
 
     // check the enyo bundle version
@@ -880,6 +1175,82 @@ QJsonObject WebAppManager::getWebProcessProfiling()
     return m_webProcessManager->getWebProcessProfiling();
 }
 
+QJsonObject WebAppManager::getCrashRecoveryStats()
+{
+    return m_crashRecoveryManager->getCrashRecoveryStats();
+}
+
+QJsonObject WebAppManager::getBackgroundCpuStats()
+{
+    return m_backgroundCpuBudget->getBackgroundCpuStats();
+}
+
+QJsonObject WebAppManager::getKeepAliveTrimStats()
+{
+    return m_keepAliveTrimmer->getKeepAliveTrimStats();
+}
+
+QJsonObject WebAppManager::getIdleTaskStats()
+{
+    return m_idleTaskScheduler->getIdleTaskStats();
+}
+
+QJsonObject WebAppManager::getLaunchSchedulerStats()
+{
+    return m_launchScheduler->getLaunchSchedulerStats();
+}
+
+QJsonObject WebAppManager::getLowPowerStats()
+{
+    return m_lowPowerManager->getLowPowerStats();
+}
+
+QJsonObject WebAppManager::getExclusiveModeStats()
+{
+    return m_exclusiveModeManager->getExclusiveModeStats();
+}
+
+QJsonObject WebAppManager::getLaunchBoostStats()
+{
+    return m_launchBoost->getLaunchBoostStats();
+}
+
+QJsonObject WebAppManager::getDiskWriteStats()
+{
+    return m_diskWriteBudget->getDiskWriteStats();
+}
+
+QJsonObject WebAppManager::getDeepSuspendStats()
+{
+    return m_cgroupManager->getDeepSuspendStats();
+}
+
+QJsonObject WebAppManager::getSuspendDelayStats()
+{
+    return m_suspendDelayScheduler->getSuspendDelayStats();
+}
+
+QJsonObject WebAppManager::getReclaimCandidates()
+{
+    return m_appEvictionManager->getReclaimCandidates();
+}
+
+void WebAppManager::appFrameSwapped(const QString& appId)
+{
+    // First frame of a cold launch, the restore cost of a discarded app
+    int launchTime = m_launchScheduler->coldLaunchTime(appId);
+    if (launchTime)
+        m_appEvictionManager->appLaunchFinished(appId, launchTime);
+
+    m_launchBoost->frameSwapped(appId);
+    m_launchScheduler->launchFinished(appId);
+}
+
+void WebAppManager::appRestored(const QString& appId, int restoreTime)
+{
+    m_appEvictionManager->appRestored(appId, restoreTime);
+}
+
 #ifndef PRELOADMANAGER_ENABLED
 void WebAppManager::sendLaunchContainerApp()
 {
@@ -968,6 +1339,14 @@ void WebAppManager::postRunningAppList()
 
 void WebAppManager::postWebProcessCreated(const QString& appId, uint32_t pid)
 {
+    if (m_webProcessManager) {
+        m_webProcessManager->setAppMemoryBaseline(appId, pid);
+        m_webProcessManager->watchWebProcess(appId, pid);
+        m_webProcessManager->updateWebProcessPriority(pid);
+    }
+    m_cgroupManager->webProcessCreated(pid);
+    m_launchBoost->webProcessCreated(appId, pid);
+
     if (!m_serviceSender)
         return;
 
@@ -1050,7 +1429,31 @@ bool WebAppManager::isEnyoApp(const QString& appId)
 
 void WebAppManager::clearBrowsingData(const int removeBrowsingDataMask)
 {
+    int ioPriority = lowerIoPriority();
     m_webProcessManager->clearBrowsingData(removeBrowsingDataMask);
+    restoreIoPriority(ioPriority);
+}
+
+int WebAppManager::lowerIoPriority()
+{
+    // Storage housekeeping must not delay the disk reads of a launching app
+    if (!m_webAppManagerConfig->isIoPriorityEnabled())
+        return -1;
+
+    int ioPriority = WebAppManagerUtils::getThreadIoPriority();
+    if (ioPriority == -1
+        || !WebAppManagerUtils::setThreadIoPriority(WebAppManagerUtils::ioPriority(WebAppManagerUtils::IoPriorityClassIdle, 0))) {
+        LOG_WARNING(MSGID_IO_PRIORITY, 0, "Fail to lower I/O priority for housekeeping");
+        return -1;
+    }
+
+    return ioPriority;
+}
+
+void WebAppManager::restoreIoPriority(int ioPriority)
+{
+    if (ioPriority != -1)
+        WebAppManagerUtils::setThreadIoPriority(ioPriority);
 }
 
 int WebAppManager::maskForBrowsingDataType(const char* type)
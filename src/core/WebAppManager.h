@@ -28,12 +28,27 @@
 
 #include "webos/webview_base.h"
 
+class AppEvictionManager;
 class ApplicationDescription;
+class BackgroundCpuBudget;
+class CgroupManager;
+class CloseGraceManager;
 class ContainerAppManager;
+class CrashRecoveryManager;
 class DeviceInfo;
+class DiskWriteBudget;
+class ExclusiveModeManager;
+class IdleTaskScheduler;
+class KeepAliveTrimmer;
+class LaunchBoost;
+class LaunchScheduler;
+class LowPowerManager;
 class NetworkStatusManager;
 class PlatformModuleFactory;
+class PreloadAdmission;
+class PsiMonitor;
 class ServiceSender;
+class SuspendDelayScheduler;
 class WebProcessManager;
 class WebAppManagerConfig;
 class WebAppBase;
@@ -67,6 +82,13 @@ public:
     void broadcastWebAppMessage(WebAppMessageType type, const QString& message);
 
     WebProcessManager* getWebProcessManager() { return m_webProcessManager; }
+    SuspendDelayScheduler* getSuspendDelayScheduler() { return m_suspendDelayScheduler; }
+    CgroupManager* getCgroupManager() { return m_cgroupManager; }
+    ContainerAppManager* getContainerAppManager() { return m_containerAppManager; }
+    KeepAliveTrimmer* getKeepAliveTrimmer() { return m_keepAliveTrimmer; }
+    LaunchScheduler* getLaunchScheduler() { return m_launchScheduler; }
+    IdleTaskScheduler* getIdleTaskScheduler() { return m_idleTaskScheduler; }
+    ExclusiveModeManager* getExclusiveModeManager() { return m_exclusiveModeManager; }
 
     virtual ~WebAppManager();
 
@@ -84,10 +106,33 @@ public:
         const std::string& launchingAppId,
         int& errCode,
         std::string& errMsg);
+    void launchQueuedPreload(const std::string& appDescString,
+        const std::string& params,
+        const std::string& launchingAppId,
+        const std::string& instanceId);
+    void launchDeferredPreload(const QString& appId,
+        const std::string& appDescString,
+        const std::string& params,
+        const std::string& launchingAppId,
+        const std::string& instanceId);
 
     std::vector<ApplicationInfo> list(bool includeSystemApps = false);
 
     QJsonObject getWebProcessProfiling();
+    QJsonObject getCrashRecoveryStats();
+    QJsonObject getReclaimCandidates();
+    QJsonObject getSuspendDelayStats();
+    QJsonObject getBackgroundCpuStats();
+    QJsonObject getDeepSuspendStats();
+    QJsonObject getDiskWriteStats();
+    QJsonObject getLaunchBoostStats();
+    QJsonObject getKeepAliveTrimStats();
+    QJsonObject getLaunchSchedulerStats();
+    QJsonObject getIdleTaskStats();
+    QJsonObject getLowPowerStats();
+    QJsonObject getExclusiveModeStats();
+    void appRestored(const QString& appId, int restoreTime);
+    void appFrameSwapped(const QString& appId);
 #ifndef PRELOADMANAGER_ENABLED
     void sendLaunchContainerApp();
     void startContainerTimer();
@@ -105,7 +150,7 @@ public:
     int currentUiHeight();
     void setUiSize(int width, int height);
 
-    void setActiveAppId(QString id) { m_activeAppId = id; }
+    void setActiveAppId(QString id);
     const QString getActiveAppId() { return m_activeAppId; }
 
     void onGlobalProperties(int key);
@@ -128,11 +173,12 @@ public:
     void requestKillWebProcess(uint32_t pid);
     bool shouldLaunchContainerAppOnDemand();
 
-    int getSuspendDelay() { return m_suspendDelay; }
     void deleteStorageData(const QString& identifier);
+    void deleteStorageDataNow(const QString& identifier);
     void killCustomPluginProcess(const QString& basePath);
     bool processCrashed(QString appId);
 
+    bool deferCloseApp(WebAppBase* app);
     void closeAppInternal(WebAppBase* app, bool ignoreCleanResource = false);
     void forceCloseAppInternal(WebAppBase* app);
 
@@ -153,6 +199,11 @@ public:
     void serviceCall(const QString& url, const QString& payload, const QString& appId);
     void updateNetworkStatus(const QJsonObject& object);
     void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level);
+    bool isPsiMonitorRunning();
+    bool setPowerState(const QString& state);
+    bool isLowPowerMode();
+    void setExclusiveForeground(const QString& appId, bool exclusive);
+    bool isExclusiveMode();
 
     bool isEnyoApp(const QString& appId);
 
@@ -164,6 +215,8 @@ public:
 protected:
 private:
     void loadEnvironmentVariable();
+    int lowerIoPriority();
+    void restoreIoPriority(int ioPriority);
 
     WebAppBase* onLaunchUrl(const std::string& url, QString winType,
         const ApplicationDescription* appDesc, const std::string& instanceId,
@@ -204,10 +257,21 @@ private:
     DeviceInfo* m_deviceInfo;
     WebAppManagerConfig* m_webAppManagerConfig;
     NetworkStatusManager* m_networkStatusManager;
-
-    QMap<QString, int> m_lastCrashedAppIds;
-
-    int m_suspendDelay;
+    CrashRecoveryManager* m_crashRecoveryManager;
+    AppEvictionManager* m_appEvictionManager;
+    CloseGraceManager* m_closeGraceManager;
+    SuspendDelayScheduler* m_suspendDelayScheduler;
+    BackgroundCpuBudget* m_backgroundCpuBudget;
+    CgroupManager* m_cgroupManager;
+    DiskWriteBudget* m_diskWriteBudget;
+    LaunchBoost* m_launchBoost;
+    PsiMonitor* m_psiMonitor;
+    KeepAliveTrimmer* m_keepAliveTrimmer;
+    PreloadAdmission* m_preloadAdmission;
+    LaunchScheduler* m_launchScheduler;
+    IdleTaskScheduler* m_idleTaskScheduler;
+    LowPowerManager* m_lowPowerManager;
+    ExclusiveModeManager* m_exclusiveModeManager;
 
     std::map<std::string, std::string> m_appVersion;
 
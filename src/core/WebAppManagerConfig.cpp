@@ -17,6 +17,9 @@
 #include "WebAppManagerConfig.h"
 
 #include <unistd.h>
+#include <algorithm>
+
+#include <QStringList>
 
 WebAppManagerConfig::WebAppManagerConfig()
     : m_suspendDelayTime(0)
@@ -28,6 +31,52 @@ WebAppManagerConfig::WebAppManagerConfig()
     , m_checkLaunchTimeEnabled(false)
     , m_useSystemAppOptimization(false)
     , m_launchOptimizationEnabled(false)
+    , m_quarantineCrashThreshold(3)
+    , m_quarantineMemoryGrowthThreshold(200)
+    , m_quarantineExpireTime(7 * 24 * 60 * 60)
+    , m_reclaimStageInterval(2000)
+    , m_reclaimTerminateTimeout(3000)
+    , m_reclaimTarget(0)
+    , m_crashRecoveryLimit(3)
+    , m_crashRecoveryBaseDelay(200)
+    , m_crashRecoveryMaxDelay(30000)
+    , m_crashRecoveryStablePeriod(60)
+    , m_appEvictionEnabled(false)
+    , m_closeGracePeriod(0)
+    , m_adaptiveSuspendDelayEnabled(false)
+    , m_suspendDelayMin(1000)
+    , m_suspendDelayMax(10000)
+    , m_backgroundCpuPeriod(1000)
+    , m_deepSuspendIdleTime(0)
+    , m_oomScoreAdjEnabled(false)
+    , m_procRoot(QLatin1String("/proc"))
+    , m_ioPriorityEnabled(false)
+    , m_diskWriteAccountingEnabled(false)
+    , m_diskWritePeriod(60)
+    , m_cpuAffinityEnabled(false)
+    , m_sysfsRoot(QLatin1String("/sys"))
+    , m_launchBoostEnabled(false)
+    , m_launchBoostNice(5)
+    , m_launchBoostUclampMin(0)
+    , m_launchBoostTimeout(3000)
+    , m_launchBoostHoldback(0)
+    , m_psiMonitorEnabled(false)
+    , m_psiMemoryPath(QLatin1String("/proc/pressure/memory"))
+    , m_psiLowStall(70)
+    , m_psiCriticalStall(100)
+    , m_psiWindow(1000)
+    , m_psiReleaseTime(10000)
+    , m_keepAliveTrimDelay(0)
+    , m_keepAliveSecondTrimDelay(300)
+    , m_keepAliveTrimStagger(2000)
+    , m_memoryPressureEventInterval(5000)
+    , m_preloadMemoryBudget(0)
+    , m_preloadMemoryEstimate(60 * 1024)
+    , m_bootSequenceDuration(60)
+    , m_preloadStagger(1000)
+    , m_idleTaskCpuIdleThreshold(70)
+    , m_lowPowerTimerSlack(50000)
+    , m_exclusiveRestoreDelay(3000)
 {
     initConfiguration();
 }
@@ -73,6 +122,197 @@ void WebAppManagerConfig::initConfiguration()
         m_userScriptPath = QLatin1String("webOSUserScripts/userScript.js");
 
     m_name = qgetenv("WAM_NAME").data();
+
+    m_quarantineListPath = QLatin1String(qgetenv("WAM_QUARANTINE_LIST_PATH"));
+    if (m_quarantineListPath.isEmpty())
+        m_quarantineListPath = QLatin1String("/var/lib/wam/quarantine.json");
+
+    // 0 disables the corresponding criterion
+    if (!qgetenv("WAM_QUARANTINE_CRASH_THRESHOLD").isEmpty())
+        m_quarantineCrashThreshold = qgetenv("WAM_QUARANTINE_CRASH_THRESHOLD").toUInt();
+
+    if (!qgetenv("WAM_QUARANTINE_MEMORY_GROWTH_IN_MB").isEmpty())
+        m_quarantineMemoryGrowthThreshold = qgetenv("WAM_QUARANTINE_MEMORY_GROWTH_IN_MB").toUInt();
+
+    if (!qgetenv("WAM_QUARANTINE_EXPIRE_IN_SEC").isEmpty())
+        m_quarantineExpireTime = qgetenv("WAM_QUARANTINE_EXPIRE_IN_SEC").toUInt();
+
+    if (!qgetenv("WAM_RECLAIM_STAGE_INTERVAL_IN_MS").isEmpty())
+        m_reclaimStageInterval = qgetenv("WAM_RECLAIM_STAGE_INTERVAL_IN_MS").toUInt();
+
+    if (!qgetenv("WAM_RECLAIM_TERMINATE_TIMEOUT_IN_MS").isEmpty())
+        m_reclaimTerminateTimeout = qgetenv("WAM_RECLAIM_TERMINATE_TIMEOUT_IN_MS").toUInt();
+
+    // Stop escalating once this much has been recovered; 0 always escalates up to SIGKILL
+    if (!qgetenv("WAM_RECLAIM_TARGET_IN_MB").isEmpty())
+        m_reclaimTarget = qgetenv("WAM_RECLAIM_TARGET_IN_MB").toUInt();
+
+    if (qgetenv("WAM_CRASH_RECOVERY_LIMIT").toUInt())
+        m_crashRecoveryLimit = qgetenv("WAM_CRASH_RECOVERY_LIMIT").toUInt();
+
+    if (qgetenv("WAM_CRASH_RECOVERY_BASE_DELAY_IN_MS").toUInt())
+        m_crashRecoveryBaseDelay = qgetenv("WAM_CRASH_RECOVERY_BASE_DELAY_IN_MS").toUInt();
+
+    if (qgetenv("WAM_CRASH_RECOVERY_MAX_DELAY_IN_MS").toUInt())
+        m_crashRecoveryMaxDelay = qgetenv("WAM_CRASH_RECOVERY_MAX_DELAY_IN_MS").toUInt();
+
+    if (qgetenv("WAM_CRASH_STABLE_PERIOD_IN_SEC").toUInt())
+        m_crashRecoveryStablePeriod = qgetenv("WAM_CRASH_STABLE_PERIOD_IN_SEC").toUInt();
+
+    if (qgetenv("ENABLE_APP_EVICTION") == "1")
+        m_appEvictionEnabled = true;
+
+    // Closed apps are kept hidden and suspended this long; 0 closes right away
+    if (!qgetenv("WAM_CLOSE_GRACE_PERIOD_IN_SEC").isEmpty())
+        m_closeGracePeriod = qgetenv("WAM_CLOSE_GRACE_PERIOD_IN_SEC").toUInt();
+
+    if (qgetenv("ENABLE_ADAPTIVE_SUSPEND_DELAY") == "1")
+        m_adaptiveSuspendDelayEnabled = true;
+
+    // Bounds of the learned delay; WAM_SUSPEND_DELAY_IN_MS stays within them
+    if (!qgetenv("WAM_SUSPEND_DELAY_MIN_IN_MS").isEmpty())
+        m_suspendDelayMin = std::max(qgetenv("WAM_SUSPEND_DELAY_MIN_IN_MS").toUInt(), 1u);
+
+    if (qgetenv("WAM_SUSPEND_DELAY_MAX_IN_MS").toUInt())
+        m_suspendDelayMax = qgetenv("WAM_SUSPEND_DELAY_MAX_IN_MS").toUInt();
+
+    // CPU budget of hidden enableBackgroundRun apps per trust level,
+    // e.g. "default:10,trusted:25" in percent of one CPU
+    QStringList budgets = QString(qgetenv("WAM_BACKGROUND_CPU_BUDGET")).split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < budgets.size(); i++) {
+        QStringList budget = budgets.at(i).split(':');
+        if (budget.size() == 2 && budget.at(1).toUInt())
+            m_backgroundCpuBudgets.insert(budget.at(0).trimmed(), budget.at(1).toUInt());
+    }
+
+    if (qgetenv("WAM_BACKGROUND_CPU_PERIOD_IN_MS").toInt() > 0)
+        m_backgroundCpuPeriod = qgetenv("WAM_BACKGROUND_CPU_PERIOD_IN_MS").toInt();
+
+    // cgroup v2 directory holding the foreground, background and preload groups
+    m_cgroupRoot = QLatin1String(qgetenv("WAM_CGROUP_ROOT"));
+
+    // memory.high of the groups, e.g. "background:300,preload:150" in MB
+    QStringList memoryHighs = QString(qgetenv("WAM_CGROUP_MEMORY_HIGH_IN_MB")).split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < memoryHighs.size(); i++) {
+        QStringList memoryHigh = memoryHighs.at(i).split(':');
+        if (memoryHigh.size() == 2 && memoryHigh.at(1).toUInt())
+            m_cgroupMemoryHigh.insert(memoryHigh.at(0).trimmed(), memoryHigh.at(1).toUInt());
+    }
+
+    // Renderers idle in the background for this long are frozen, 0 never freezes
+    m_deepSuspendIdleTime = qgetenv("WAM_DEEP_SUSPEND_IDLE_IN_SEC").toUInt();
+
+    if (qgetenv("ENABLE_OOM_SCORE_ADJ") == "1")
+        m_oomScoreAdjEnabled = true;
+
+    // Overrides of the renderer oom_score_adj policy, e.g. "foreground:-100,preload:900"
+    QStringList oomScoreAdjs = QString(qgetenv("WAM_OOM_SCORE_ADJ")).split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < oomScoreAdjs.size(); i++) {
+        QStringList oomScoreAdj = oomScoreAdjs.at(i).split(':');
+        bool ok = false;
+        int value = oomScoreAdj.size() == 2 ? oomScoreAdj.at(1).toInt(&ok) : 0;
+        if (ok && value >= -1000 && value <= 1000)
+            m_oomScoreAdjs.insert(oomScoreAdj.at(0).trimmed(), value);
+    }
+
+    // Lets /proc be pointed at a fake tree, for oom_score_adj writes and PSS reads
+    if (!qgetenv("WAM_PROC_ROOT").isEmpty())
+        m_procRoot = QLatin1String(qgetenv("WAM_PROC_ROOT"));
+
+    if (qgetenv("ENABLE_IO_PRIORITY") == "1")
+        m_ioPriorityEnabled = true;
+
+    if (qgetenv("ENABLE_DISK_WRITE_ACCOUNTING") == "1")
+        m_diskWriteAccountingEnabled = true;
+
+    // Write budget per app class, e.g. "background:2048,preload:512" in KB per period
+    QStringList writeBudgets = QString(qgetenv("WAM_DISK_WRITE_BUDGET")).split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < writeBudgets.size(); i++) {
+        QStringList writeBudget = writeBudgets.at(i).split(':');
+        if (writeBudget.size() == 2 && writeBudget.at(1).toUInt())
+            m_diskWriteBudgets.insert(writeBudget.at(0).trimmed(), writeBudget.at(1).toUInt());
+    }
+
+    if (qgetenv("WAM_DISK_WRITE_PERIOD_IN_SEC").toUInt() > 0)
+        m_diskWritePeriod = qgetenv("WAM_DISK_WRITE_PERIOD_IN_SEC").toUInt();
+
+    if (qgetenv("ENABLE_CPU_AFFINITY") == "1")
+        m_cpuAffinityEnabled = true;
+
+    // Lets the CPU topology be read from a fake tree
+    if (!qgetenv("WAM_SYSFS_ROOT").isEmpty())
+        m_sysfsRoot = QLatin1String(qgetenv("WAM_SYSFS_ROOT"));
+
+    if (qgetenv("ENABLE_LAUNCH_BOOST") == "1")
+        m_launchBoostEnabled = true;
+
+    // Nice steps the boost takes off, or uclamp.min out of 1024 when set
+    if (qgetenv("WAM_LAUNCH_BOOST_NICE").toInt() > 0)
+        m_launchBoostNice = std::min(qgetenv("WAM_LAUNCH_BOOST_NICE").toInt(), 20);
+    m_launchBoostUclampMin = std::min(qgetenv("WAM_LAUNCH_BOOST_UCLAMP_MIN").toUInt(), 1024u);
+
+    if (qgetenv("WAM_LAUNCH_BOOST_TIMEOUT_IN_MS").toUInt() > 0)
+        m_launchBoostTimeout = qgetenv("WAM_LAUNCH_BOOST_TIMEOUT_IN_MS").toUInt();
+
+    // Every Nth launch runs unboosted to measure the improvement, 0 boosts all
+    m_launchBoostHoldback = qgetenv("WAM_LAUNCH_BOOST_HOLDBACK").toUInt();
+
+    if (qgetenv("ENABLE_PSI_MONITOR") == "1")
+        m_psiMonitorEnabled = true;
+
+    if (!qgetenv("WAM_PSI_MEMORY_PATH").isEmpty())
+        m_psiMemoryPath = QLatin1String(qgetenv("WAM_PSI_MEMORY_PATH"));
+
+    if (qgetenv("WAM_PSI_LOW_STALL_IN_MS").toUInt() > 0)
+        m_psiLowStall = qgetenv("WAM_PSI_LOW_STALL_IN_MS").toUInt();
+
+    if (qgetenv("WAM_PSI_CRITICAL_STALL_IN_MS").toUInt() > 0)
+        m_psiCriticalStall = qgetenv("WAM_PSI_CRITICAL_STALL_IN_MS").toUInt();
+
+    if (qgetenv("WAM_PSI_WINDOW_IN_MS").toUInt() > 0)
+        m_psiWindow = qgetenv("WAM_PSI_WINDOW_IN_MS").toUInt();
+
+    // How long a level's triggers must stay quiet before it is left
+    if (qgetenv("WAM_PSI_RELEASE_IN_MS").toUInt() > 0)
+        m_psiReleaseTime = qgetenv("WAM_PSI_RELEASE_IN_MS").toUInt();
+
+    // Trims of hidden keepAlive apps, counted from when the app is hidden, 0 never trims
+    m_keepAliveTrimDelay = qgetenv("WAM_KEEPALIVE_TRIM_DELAY_IN_SEC").toUInt();
+    if (qgetenv("WAM_KEEPALIVE_SECOND_TRIM_DELAY_IN_SEC").toUInt() > 0)
+        m_keepAliveSecondTrimDelay = qgetenv("WAM_KEEPALIVE_SECOND_TRIM_DELAY_IN_SEC").toUInt();
+    m_keepAliveSecondTrimDelay = std::max(m_keepAliveSecondTrimDelay, m_keepAliveTrimDelay);
+
+    if (qgetenv("WAM_KEEPALIVE_TRIM_STAGGER_IN_MS").toInt() > 0)
+        m_keepAliveTrimStagger = qgetenv("WAM_KEEPALIVE_TRIM_STAGGER_IN_MS").toInt();
+
+    // Minimum gap between webOSMemoryPressure events of a page, rising levels are not held back
+    if (qgetenv("WAM_MEMORY_PRESSURE_EVENT_INTERVAL_IN_MS").toUInt() > 0)
+        m_memoryPressureEventInterval = qgetenv("WAM_MEMORY_PRESSURE_EVENT_INTERVAL_IN_MS").toUInt();
+
+    // Memory of hidden and preloaded apps in KB, 0 admits every preload
+    m_preloadMemoryBudget = qgetenv("WAM_PRELOAD_MEMORY_BUDGET_IN_MB").toUInt() * 1024;
+    // Cost of a preload that was never measured before
+    if (qgetenv("WAM_PRELOAD_MEMORY_ESTIMATE_IN_MB").toUInt() > 0)
+        m_preloadMemoryEstimate = qgetenv("WAM_PRELOAD_MEMORY_ESTIMATE_IN_MB").toUInt() * 1024;
+
+    // Preloads started within the boot sequence are kept WAM_PRELOAD_STAGGER_IN_MS apart
+    if (!qgetenv("WAM_BOOT_SEQUENCE_IN_SEC").isEmpty())
+        m_bootSequenceDuration = qgetenv("WAM_BOOT_SEQUENCE_IN_SEC").toUInt();
+    if (!qgetenv("WAM_PRELOAD_STAGGER_IN_MS").isEmpty())
+        m_preloadStagger = qgetenv("WAM_PRELOAD_STAGGER_IN_MS").toUInt();
+
+    // Percent of CPU time that must be idle for deferred maintenance to run
+    if (!qgetenv("WAM_IDLE_TASK_CPU_IDLE_PERCENT").isEmpty())
+        m_idleTaskCpuIdleThreshold = std::min(qgetenv("WAM_IDLE_TASK_CPU_IDLE_PERCENT").toUInt(), 100u);
+
+    // Apps kept running in low-power mode, e.g. "com.webos.app.alarm,com.webos.app.voice"
+    m_lowPowerExemptApps = QString(qgetenv("WAM_LOW_POWER_EXEMPT_APPS")).split(',', QString::SkipEmptyParts);
+
+    if (!qgetenv("WAM_LOW_POWER_TIMER_SLACK_IN_US").isEmpty())
+        m_lowPowerTimerSlack = qgetenv("WAM_LOW_POWER_TIMER_SLACK_IN_US").toUInt();
+
+    if (!qgetenv("WAM_EXCLUSIVE_RESTORE_DELAY_IN_MS").isEmpty())
+        m_exclusiveRestoreDelay = std::max(qgetenv("WAM_EXCLUSIVE_RESTORE_DELAY_IN_MS").toInt(), 0);
 }
 
 QVariant WebAppManagerConfig::getConfiguration(QString name)
@@ -19,6 +19,7 @@
 
 #include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QVariant>
 
 class WebAppManagerConfig {
@@ -45,6 +46,61 @@ public:
 
     virtual bool isLaunchOptimizationEnabled() const { return m_launchOptimizationEnabled; }
 
+    virtual QString getQuarantineListPath() const { return m_quarantineListPath; }
+    virtual uint32_t getQuarantineCrashThreshold() const { return m_quarantineCrashThreshold; }
+    virtual uint32_t getQuarantineMemoryGrowthThreshold() const { return m_quarantineMemoryGrowthThreshold; }
+    virtual uint32_t getQuarantineExpireTime() const { return m_quarantineExpireTime; }
+    virtual uint32_t getReclaimStageInterval() const { return m_reclaimStageInterval; }
+    virtual uint32_t getReclaimTerminateTimeout() const { return m_reclaimTerminateTimeout; }
+    virtual uint32_t getReclaimTarget() const { return m_reclaimTarget; }
+    virtual uint32_t getCrashRecoveryLimit() const { return m_crashRecoveryLimit; }
+    virtual uint32_t getCrashRecoveryBaseDelay() const { return m_crashRecoveryBaseDelay; }
+    virtual uint32_t getCrashRecoveryMaxDelay() const { return m_crashRecoveryMaxDelay; }
+    virtual uint32_t getCrashRecoveryStablePeriod() const { return m_crashRecoveryStablePeriod; }
+    virtual bool isAppEvictionEnabled() const { return m_appEvictionEnabled; }
+    virtual uint32_t getCloseGracePeriod() const { return m_closeGracePeriod; }
+    virtual bool isAdaptiveSuspendDelayEnabled() const { return m_adaptiveSuspendDelayEnabled; }
+    virtual uint32_t getSuspendDelayMin() const { return m_suspendDelayMin; }
+    virtual uint32_t getSuspendDelayMax() const { return m_suspendDelayMax; }
+    virtual bool hasBackgroundCpuBudget() const { return !m_backgroundCpuBudgets.isEmpty(); }
+    virtual uint32_t getBackgroundCpuBudget(const QString& trustLevel) const { return m_backgroundCpuBudgets.value(trustLevel, 0); }
+    virtual int getBackgroundCpuPeriod() const { return m_backgroundCpuPeriod; }
+    virtual QString getCgroupRoot() const { return m_cgroupRoot; }
+    virtual uint32_t getCgroupMemoryHigh(const QString& cgroup) const { return m_cgroupMemoryHigh.value(cgroup, 0); }
+    virtual uint32_t getDeepSuspendIdleTime() const { return m_deepSuspendIdleTime; }
+    virtual bool isOomScoreAdjEnabled() const { return m_oomScoreAdjEnabled; }
+    virtual int getOomScoreAdj(const QString& state, int defaultValue) const { return m_oomScoreAdjs.value(state, defaultValue); }
+    virtual QString getProcRoot() const { return m_procRoot; }
+    virtual bool isIoPriorityEnabled() const { return m_ioPriorityEnabled; }
+    virtual bool isDiskWriteAccountingEnabled() const { return m_diskWriteAccountingEnabled; }
+    virtual uint32_t getDiskWriteBudget(const QString& appClass) const { return m_diskWriteBudgets.value(appClass, 0); }
+    virtual uint32_t getDiskWritePeriod() const { return m_diskWritePeriod; }
+    virtual bool isCpuAffinityEnabled() const { return m_cpuAffinityEnabled; }
+    virtual QString getSysfsRoot() const { return m_sysfsRoot; }
+    virtual bool isLaunchBoostEnabled() const { return m_launchBoostEnabled; }
+    virtual int getLaunchBoostNice() const { return m_launchBoostNice; }
+    virtual uint32_t getLaunchBoostUclampMin() const { return m_launchBoostUclampMin; }
+    virtual uint32_t getLaunchBoostTimeout() const { return m_launchBoostTimeout; }
+    virtual uint32_t getLaunchBoostHoldback() const { return m_launchBoostHoldback; }
+    virtual bool isPsiMonitorEnabled() const { return m_psiMonitorEnabled; }
+    virtual QString getPsiMemoryPath() const { return m_psiMemoryPath; }
+    virtual uint32_t getPsiLowStall() const { return m_psiLowStall; }
+    virtual uint32_t getPsiCriticalStall() const { return m_psiCriticalStall; }
+    virtual uint32_t getPsiWindow() const { return m_psiWindow; }
+    virtual uint32_t getPsiReleaseTime() const { return m_psiReleaseTime; }
+    virtual uint32_t getKeepAliveTrimDelay() const { return m_keepAliveTrimDelay; }
+    virtual uint32_t getKeepAliveSecondTrimDelay() const { return m_keepAliveSecondTrimDelay; }
+    virtual int getKeepAliveTrimStagger() const { return m_keepAliveTrimStagger; }
+    virtual uint32_t getMemoryPressureEventInterval() const { return m_memoryPressureEventInterval; }
+    virtual uint32_t getPreloadMemoryBudget() const { return m_preloadMemoryBudget; }
+    virtual uint32_t getPreloadMemoryEstimate() const { return m_preloadMemoryEstimate; }
+    virtual uint32_t getBootSequenceDuration() const { return m_bootSequenceDuration; }
+    virtual uint32_t getPreloadStagger() const { return m_preloadStagger; }
+    virtual uint32_t getIdleTaskCpuIdleThreshold() const { return m_idleTaskCpuIdleThreshold; }
+    virtual bool isLowPowerExemptApp(const QString& appId) const { return m_lowPowerExemptApps.contains(appId); }
+    virtual uint32_t getLowPowerTimerSlack() const { return m_lowPowerTimerSlack; }
+    virtual int getExclusiveRestoreDelay() const { return m_exclusiveRestoreDelay; }
+
 protected:
     virtual QVariant getConfiguration(QString name);
     virtual void setConfiguration(QString name, QVariant value);
@@ -68,6 +124,59 @@ private:
     bool m_launchOptimizationEnabled;
     QString m_userScriptPath;
     std::string m_name;
+    QString m_quarantineListPath;
+    uint32_t m_quarantineCrashThreshold;
+    uint32_t m_quarantineMemoryGrowthThreshold;
+    uint32_t m_quarantineExpireTime;
+    uint32_t m_reclaimStageInterval;
+    uint32_t m_reclaimTerminateTimeout;
+    uint32_t m_reclaimTarget;
+    uint32_t m_crashRecoveryLimit;
+    uint32_t m_crashRecoveryBaseDelay;
+    uint32_t m_crashRecoveryMaxDelay;
+    uint32_t m_crashRecoveryStablePeriod;
+    bool m_appEvictionEnabled;
+    uint32_t m_closeGracePeriod;
+    bool m_adaptiveSuspendDelayEnabled;
+    uint32_t m_suspendDelayMin;
+    uint32_t m_suspendDelayMax;
+    QMap<QString, uint32_t> m_backgroundCpuBudgets; // percent of one CPU per trust level
+    int m_backgroundCpuPeriod;
+    QString m_cgroupRoot;
+    QMap<QString, uint32_t> m_cgroupMemoryHigh; // MB per cgroup, 0 is unlimited
+    uint32_t m_deepSuspendIdleTime;
+    bool m_oomScoreAdjEnabled;
+    QMap<QString, int> m_oomScoreAdjs; // oom_score_adj per renderer state
+    QString m_procRoot;
+    bool m_ioPriorityEnabled;
+    bool m_diskWriteAccountingEnabled;
+    QMap<QString, uint32_t> m_diskWriteBudgets; // KB per period per app class
+    uint32_t m_diskWritePeriod;
+    bool m_cpuAffinityEnabled;
+    QString m_sysfsRoot;
+    bool m_launchBoostEnabled;
+    int m_launchBoostNice;
+    uint32_t m_launchBoostUclampMin; // 0 boosts with nice only
+    uint32_t m_launchBoostTimeout;
+    uint32_t m_launchBoostHoldback;
+    bool m_psiMonitorEnabled;
+    QString m_psiMemoryPath;
+    uint32_t m_psiLowStall; // ms of "some" stall per window
+    uint32_t m_psiCriticalStall; // ms of "full" stall per window
+    uint32_t m_psiWindow;
+    uint32_t m_psiReleaseTime;
+    uint32_t m_keepAliveTrimDelay;
+    uint32_t m_keepAliveSecondTrimDelay;
+    int m_keepAliveTrimStagger;
+    uint32_t m_memoryPressureEventInterval;
+    uint32_t m_preloadMemoryBudget;
+    uint32_t m_preloadMemoryEstimate;
+    uint32_t m_bootSequenceDuration;
+    uint32_t m_preloadStagger;
+    uint32_t m_idleTaskCpuIdleThreshold;
+    QStringList m_lowPowerExemptApps;
+    uint32_t m_lowPowerTimerSlack; // usecs
+    int m_exclusiveRestoreDelay;
 
     QMap<QString, QVariant> m_configuration;
 };
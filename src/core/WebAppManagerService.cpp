@@ -82,6 +82,76 @@ QJsonObject WebAppManagerService::getWebProcessProfiling()
     return WebAppManager::instance()->getWebProcessProfiling();
 }
 
+QJsonObject WebAppManagerService::onGetCrashRecoveryStats()
+{
+    return WebAppManager::instance()->getCrashRecoveryStats();
+}
+
+QJsonObject WebAppManagerService::onGetReclaimCandidates()
+{
+    return WebAppManager::instance()->getReclaimCandidates();
+}
+
+QJsonObject WebAppManagerService::onGetSuspendDelayStats()
+{
+    return WebAppManager::instance()->getSuspendDelayStats();
+}
+
+QJsonObject WebAppManagerService::onGetBackgroundCpuStats()
+{
+    return WebAppManager::instance()->getBackgroundCpuStats();
+}
+
+QJsonObject WebAppManagerService::onGetDeepSuspendStats()
+{
+    return WebAppManager::instance()->getDeepSuspendStats();
+}
+
+QJsonObject WebAppManagerService::onGetDiskWriteStats()
+{
+    return WebAppManager::instance()->getDiskWriteStats();
+}
+
+QJsonObject WebAppManagerService::onGetLaunchBoostStats()
+{
+    return WebAppManager::instance()->getLaunchBoostStats();
+}
+
+QJsonObject WebAppManagerService::onGetKeepAliveTrimStats()
+{
+    return WebAppManager::instance()->getKeepAliveTrimStats();
+}
+
+QJsonObject WebAppManagerService::onGetLaunchSchedulerStats()
+{
+    return WebAppManager::instance()->getLaunchSchedulerStats();
+}
+
+QJsonObject WebAppManagerService::onGetIdleTaskStats()
+{
+    return WebAppManager::instance()->getIdleTaskStats();
+}
+
+bool WebAppManagerService::onSetPowerState(const QString& state)
+{
+    return WebAppManager::instance()->setPowerState(state);
+}
+
+QJsonObject WebAppManagerService::onGetLowPowerStats()
+{
+    return WebAppManager::instance()->getLowPowerStats();
+}
+
+void WebAppManagerService::onSetExclusiveForeground(const QString& appId, bool exclusive)
+{
+    WebAppManager::instance()->setExclusiveForeground(appId, exclusive);
+}
+
+QJsonObject WebAppManagerService::onGetExclusiveModeStats()
+{
+    return WebAppManager::instance()->getExclusiveModeStats();
+}
+
 void WebAppManagerService::onClearBrowsingData(const int removeBrowsingDataMask)
 {
     WebAppManager::instance()->clearBrowsingData(removeBrowsingDataMask);
@@ -213,6 +283,10 @@ void WebAppManagerService::updateNetworkStatus(const QJsonObject& object)
 
 void WebAppManagerService::notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level)
 {
+    // The in-process PSI monitor is faster, two sources would fight over the level
+    if (WebAppManager::instance()->isPsiMonitorRunning())
+        return;
+
     WebAppManager::instance()->notifyMemoryPressure(level);
 }
 
@@ -27,15 +27,21 @@ enum ErrorCode {
     ERR_CODE_LAUNCHAPP_MISS_PARAM = 1000,
     ERR_CODE_LAUNCHAPP_UNSUPPORTED_TYPE = 1001,
     ERR_CODE_LAUNCHAPP_INVALID_TRUSTLEVEL = 1002,
+    ERR_CODE_LAUNCHAPP_PRELOAD_REJECTED = 1004,
+    ERR_CODE_LAUNCHAPP_PRELOAD_REFUSED = 1005,
     ERR_CODE_KILLAPP_NO_APP = 2000,
     ERR_CODE_CLEAR_DATA_BRAWSING_EMPTY_ARRAY = 3000,
     ERR_CODE_CLEAR_DATA_BRAWSING_INVALID_VALUE = 3001,
-    ERR_CODE_CLEAR_DATA_BRAWSING_UNKNOWN_DATA = 3002
+    ERR_CODE_CLEAR_DATA_BRAWSING_UNKNOWN_DATA = 3002,
+    ERR_CODE_POWER_STATE_INVALID_VALUE = 4000,
+    ERR_CODE_EXCLUSIVE_MISS_APP_ID = 5000
 };
 
 const std::string err_missParam = "Miss launch parameter(s)";
 const std::string err_unsupportedType = "Unsupported app type (Check subType)";
 const std::string err_invalidTrustLevel = "Invalid trust level (Check trustLevel)";
+const std::string err_preloadRejected = "Preload rejected by memory budget";
+const std::string err_preloadRefused = "Preload refused while an app is in exclusive mode";
 
 const std::string err_noRunningApp = "App is not running";
 
@@ -44,6 +50,8 @@ const std::string err_invalidValue = "Invalid value";
 const std::string err_unknownData = "Unknown data";
 const std::string err_onlyAllowedForString = "Only allowed for string type";
 
+const std::string err_missAppId = "Miss appId parameter";
+
 class WebAppBase;
 
 class WebAppManagerService {
@@ -63,6 +71,20 @@ public:
     virtual QJsonObject getWebProcessSize(QJsonObject request) = 0;
     virtual QJsonObject clearBrowsingData(QJsonObject request) = 0;
     virtual QJsonObject webProcessCreated(QJsonObject request, bool subscribed) = 0;
+    virtual QJsonObject getCrashRecoveryStats(QJsonObject request) = 0;
+    virtual QJsonObject getReclaimCandidates(QJsonObject request) = 0;
+    virtual QJsonObject getSuspendDelayStats(QJsonObject request) = 0;
+    virtual QJsonObject getBackgroundCpuStats(QJsonObject request) = 0;
+    virtual QJsonObject getDeepSuspendStats(QJsonObject request) = 0;
+    virtual QJsonObject getDiskWriteStats(QJsonObject request) = 0;
+    virtual QJsonObject getLaunchBoostStats(QJsonObject request) = 0;
+    virtual QJsonObject getKeepAliveTrimStats(QJsonObject request) = 0;
+    virtual QJsonObject getLaunchSchedulerStats(QJsonObject request) = 0;
+    virtual QJsonObject getIdleTaskStats(QJsonObject request) = 0;
+    virtual QJsonObject setPowerState(QJsonObject request) = 0;
+    virtual QJsonObject getLowPowerStats(QJsonObject request) = 0;
+    virtual QJsonObject setExclusiveForeground(QJsonObject request) = 0;
+    virtual QJsonObject getExclusiveModeStats(QJsonObject request) = 0;
 
 protected:
     std::string onLaunch(const std::string& appDescString,
@@ -79,6 +101,20 @@ protected:
     void onDiscardCodeCache(uint32_t pid);
     bool onPurgeSurfacePool(uint32_t pid);
     QJsonObject getWebProcessProfiling();
+    QJsonObject onGetCrashRecoveryStats();
+    QJsonObject onGetReclaimCandidates();
+    QJsonObject onGetSuspendDelayStats();
+    QJsonObject onGetBackgroundCpuStats();
+    QJsonObject onGetDeepSuspendStats();
+    QJsonObject onGetDiskWriteStats();
+    QJsonObject onGetLaunchBoostStats();
+    QJsonObject onGetKeepAliveTrimStats();
+    QJsonObject onGetLaunchSchedulerStats();
+    QJsonObject onGetIdleTaskStats();
+    bool onSetPowerState(const QString& state);
+    QJsonObject onGetLowPowerStats();
+    void onSetExclusiveForeground(const QString& appId, bool exclusive);
+    QJsonObject onGetExclusiveModeStats();
     QJsonObject closeByInstanceId(QString instanceId);
     int maskForBrowsingDataType(const char* type);
     void onClearBrowsingData(const int removeBrowsingDataMask);
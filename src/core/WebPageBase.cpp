@@ -16,6 +16,8 @@
 
 #include "WebPageBase.h"
 
+#include <glib.h>
+
 #include <QDir>
 #include <QFileInfo>
 #include <QtCore/QJsonDocument>
@@ -23,11 +25,36 @@
 
 #include "ApplicationDescription.h"
 #include "LogManager.h"
+#include "SuspendDelayScheduler.h"
 #include "WebAppManagerConfig.h"
 #include "WebAppManager.h"
 #include "WebPageObserver.h"
 #include "WebProcessManager.h"
 
+static int memoryPressureSeverity(webos::WebViewBase::MemoryPressureLevel level)
+{
+    switch (level) {
+    case webos::WebViewBase::MEMORY_PRESSURE_CRITICAL:
+        return 2;
+    case webos::WebViewBase::MEMORY_PRESSURE_LOW:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static const char* memoryPressureLevelName(webos::WebViewBase::MemoryPressureLevel level)
+{
+    switch (level) {
+    case webos::WebViewBase::MEMORY_PRESSURE_CRITICAL:
+        return "critical";
+    case webos::WebViewBase::MEMORY_PRESSURE_LOW:
+        return "low";
+    default:
+        return "normal";
+    }
+}
+
 #define CONSOLE_DEBUG(AAA) evaluateJavaScript(QStringLiteral("console.debug('") + QStringLiteral(AAA) + QStringLiteral("');"))
 
 WebPageBase::WebPageBase()
@@ -40,6 +67,11 @@ WebPageBase::WebPageBase()
     , m_loadErrorPolicy(QStringLiteral("default"))
     , m_cleaningResources(false)
     , m_isPreload(false)
+    , m_hasMemoryPressureListener(false)
+    , m_hasPendingMemoryPressure(false)
+    , m_pendingMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_lastMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_lastMemoryPressureTime(0)
 {
 }
 
@@ -56,6 +88,11 @@ WebPageBase::WebPageBase(const QUrl& url, ApplicationDescription* desc, const QS
     , m_loadErrorPolicy(QStringLiteral("default"))
     , m_cleaningResources(false)
     , m_isPreload(false)
+    , m_hasMemoryPressureListener(false)
+    , m_hasPendingMemoryPressure(false)
+    , m_pendingMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_lastMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+    , m_lastMemoryPressureTime(0)
 {
 }
 
@@ -238,6 +275,52 @@ void WebPageBase::sendRelaunchEvent()
         "}, 1);").arg(launchParams().isEmpty() ? "{}" : launchParams()));
 }
 
+void WebPageBase::sendMemoryPressureEvent(webos::WebViewBase::MemoryPressureLevel level)
+{
+    if (!m_hasMemoryPressureListener || isClosing())
+        return;
+
+    // Only the latest level matters once the app gets to run again
+    m_pendingMemoryPressure = level;
+    m_hasPendingMemoryPressure = true;
+    flushMemoryPressureEvent();
+}
+
+void WebPageBase::flushMemoryPressureEvent()
+{
+    if (!m_hasPendingMemoryPressure || isJavaScriptSuspended() || m_memoryPressureTimer.isRunning())
+        return;
+
+    // Rising pressure goes out at once, anything else waits for the interval
+    qint64 interval = static_cast<qint64>(getWebAppManagerConfig()->getMemoryPressureEventInterval()) * 1000;
+    qint64 elapsed = g_get_monotonic_time() - m_lastMemoryPressureTime;
+    if (m_lastMemoryPressureTime && elapsed < interval
+        && memoryPressureSeverity(m_pendingMemoryPressure) <= memoryPressureSeverity(m_lastMemoryPressure)) {
+        m_memoryPressureTimer.start((interval - elapsed) / 1000 + 1, this, &WebPageBase::flushMemoryPressureEvent);
+        return;
+    }
+
+    m_hasPendingMemoryPressure = false;
+    dispatchMemoryPressureEvent(m_pendingMemoryPressure);
+}
+
+void WebPageBase::dispatchMemoryPressureEvent(webos::WebViewBase::MemoryPressureLevel level)
+{
+    if (level == m_lastMemoryPressure && !memoryPressureSeverity(level))
+        return;
+
+    m_lastMemoryPressure = level;
+    m_lastMemoryPressureTime = g_get_monotonic_time();
+
+    LOG_INFO(MSGID_MEMORY_PRESSURE_EVENT, 3, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()),
+        PMLOGKS("LEVEL", memoryPressureLevelName(level)), "");
+    evaluateJavaScript(QStringLiteral(
+        "setTimeout(function () {"
+        "    var memoryPressureEvent=new CustomEvent('webOSMemoryPressure', { detail: { level : '%1' } });"
+        "    document.dispatchEvent(memoryPressureEvent);"
+        "}, 1);").arg(memoryPressureLevelName(level)));
+}
+
 void WebPageBase::urlChangedSlot()
 {
     Q_EMIT webPageUrlChanged();
@@ -246,6 +329,13 @@ void WebPageBase::urlChangedSlot()
 void WebPageBase::handleLoadStarted()
 {
     m_suspendAtLoad = true;
+    // A new document registers again through PalmSystem
+    m_hasMemoryPressureListener = false;
+    m_hasPendingMemoryPressure = false;
+    m_lastMemoryPressure = webos::WebViewBase::MEMORY_PRESSURE_NONE;
+    m_lastMemoryPressureTime = 0;
+    if (m_memoryPressureTimer.isRunning())
+        m_memoryPressureTimer.stop();
 }
 
 void WebPageBase::handleLoadFinished()
@@ -328,7 +418,13 @@ bool WebPageBase::processCrashed()
 
 int WebPageBase::suspendDelay()
 {
-    return WebAppManager::instance()->getSuspendDelay();
+    bool mediaCapture = m_appDesc && (m_appDesc->allowVideoCapture() || m_appDesc->allowAudioCapture());
+    return WebAppManager::instance()->getSuspendDelayScheduler()->suspendDelay(appId(), mediaCapture);
+}
+
+void WebPageBase::resumedFromSuspend()
+{
+    WebAppManager::instance()->getSuspendDelayScheduler()->appResumed(appId());
 }
 
 QString WebPageBase::telluriumNubPath()
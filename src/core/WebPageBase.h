@@ -22,6 +22,7 @@
 #include <QtCore/QUrl>
 
 #include "ObserverList.h"
+#include "Timer.h"
 
 #include "webos/webview_base.h"
 
@@ -50,6 +51,13 @@ public:
         WebPageVisibilityStateLast = WebPageVisibilityStatePrerender
     };
 
+    // Owners of a background throttle, the page runs again once none is left
+    enum BackgroundThrottleReason {
+        BackgroundThrottleCpuBudget = 1 << 0,
+        BackgroundThrottleLowPower = 1 << 1,
+        BackgroundThrottleExclusiveMode = 1 << 2
+    };
+
     WebPageBase();
     WebPageBase(const QUrl& url, ApplicationDescription* desc, const QString& params);
     virtual ~WebPageBase();
@@ -115,16 +123,25 @@ public:
     virtual void setAudioGuidanceOn(bool on) {}
     virtual void resetStateToMarkNextPaintForContainer() {}
     virtual bool isInputMethodActive() const { return false; }
+    virtual void webProcessExited(uint32_t pid) {}
+    virtual bool discardWebView() { return false; }
+    virtual void restoreWebView(const QUrl& url, const QString& state) {}
+    virtual void setBackgroundThrottled(BackgroundThrottleReason reason, bool throttled) {}
+    virtual void flushSuspendDelay() {}
 
     QString launchParams() const;
     void setApplicationDescription(ApplicationDescription* desc);
     void load();
     void setEnableBackgroundRun(bool enable) { m_enableBackgroundRun = enable; }
+    bool isEnableBackgroundRun() const { return m_enableBackgroundRun; }
     void sendLocaleChangeEvent(const QString& language);
     void setCleaningResources(bool cleaningResources) { m_cleaningResources = cleaningResources; }
     bool cleaningResources() const { return m_cleaningResources; }
     bool doHostedWebAppRelaunch(const QString& launchParams);
     void sendRelaunchEvent();
+    void setMemoryPressureListener(bool listen) { m_hasMemoryPressureListener = listen; }
+    bool hasMemoryPressureListener() const { return m_hasMemoryPressureListener; }
+    void sendMemoryPressureEvent(webos::WebViewBase::MemoryPressureLevel level);
     void setAppId(const QString& appId) { m_appId = appId; }
     const QString& appId() const { return m_appId; }
     ApplicationDescription* getAppDescription() { return m_appDesc; }
@@ -162,6 +179,9 @@ protected:
     virtual void addUserScript(const QString& script) = 0;
     virtual void addUserScriptUrl(const QUrl& url) = 0;
     virtual int suspendDelay();
+    void resumedFromSuspend();
+    void flushMemoryPressureEvent();
+    virtual bool isJavaScriptSuspended() const { return false; }
     virtual bool hasLoadErrorPolicy(bool isHttpResponseError, int errorCode);
     virtual void loadErrorPage(int errorCode) = 0;
     virtual void recreateWebView() = 0;
@@ -200,9 +220,16 @@ protected:
 private:
     void setBackgroundColorOfBody(const QString& color);
     void setupLaunchEvent();
+    void dispatchMemoryPressureEvent(webos::WebViewBase::MemoryPressureLevel level);
 
     bool m_cleaningResources;
     bool m_isPreload;
+    bool m_hasMemoryPressureListener;
+    bool m_hasPendingMemoryPressure;
+    webos::WebViewBase::MemoryPressureLevel m_pendingMemoryPressure;
+    webos::WebViewBase::MemoryPressureLevel m_lastMemoryPressure;
+    qint64 m_lastMemoryPressureTime;
+    OneShotTimer<WebPageBase> m_memoryPressureTimer;
 };
 
 #endif // WEBPAGEBASE_H
@@ -16,12 +16,17 @@
 
 #include "WebProcessManager.h"
 
+#include <algorithm>
 #include <signal.h>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonArray>
 
 #include "ApplicationDescription.h"
+#include "CgroupManager.h"
 #include "LogManager.h"
 #include "WebAppBase.h"
 #include "WebAppManagerConfig.h"
@@ -30,11 +35,64 @@
 #include "WebPageBase.h"
 
 #include <glib.h>
+#include <glib-unix.h>
+#include <unistd.h>
+
+static const int kReclaimPollIntervalMs = 200;
+
+// Crash counts are halved for every hour an app goes without crashing
+static const qint64 kCrashDecayPeriodUs = 60 * 60 * G_USEC_PER_SEC;
+
+// Default oom_score_adj per OomState, WAM_OOM_SCORE_ADJ overrides by state name
+static const int kDefaultOomScoreAdj[] = { 0, 100, 500, 700, 800, 900 };
+
+static gboolean webProcessExitedCallback(gint fd, GIOCondition condition, gpointer data)
+{
+    // pidfd becomes readable once the process has exited
+    WebProcessManager* webProcessManager = WebAppManager::instance()->getWebProcessManager();
+    if (webProcessManager)
+        webProcessManager->webProcessExited(GPOINTER_TO_UINT(data));
+
+    return G_SOURCE_REMOVE;
+}
+
+static bool chargeIncident(uint32_t& count, QStringList& commonPeers, const QStringList& peers)
+{
+    // Alone on its renderer the app hurt nobody but itself
+    if (peers.isEmpty())
+        return false;
+
+    if (!count) {
+        commonPeers = peers;
+    } else {
+        for (QStringList::iterator it = commonPeers.begin(); it != commonPeers.end();) {
+            if (peers.contains(*it))
+                ++it;
+            else
+                it = commonPeers.erase(it);
+        }
+    }
+    count++;
+    return true;
+}
 
 WebProcessManager::WebProcessManager()
     : m_maximumNumberOfProcesses(1)
+    , m_cpuTopologyRead(false)
 {
+    for (int i = 0; i < ReclaimStageCount; i++)
+        m_reclaimedMemSize[i] = 0;
+
     readWebProcessPolicy();
+    readQuarantineList();
+}
+
+WebProcessManager::~WebProcessManager()
+{
+    for (QMap<uint32_t, WebProcessWatch>::iterator it = m_webProcessWatchMap.begin(); it != m_webProcessWatchMap.end(); ++it) {
+        g_source_remove(it.value().sourceId);
+        close(it.value().pidfd);
+    }
 }
 
 std::list<const WebAppBase*> WebProcessManager::runningApps()
@@ -187,6 +245,9 @@ QString WebProcessManager::getProcessKey(const ApplicationDescription* desc) con
     if (!desc)
         return QString();
 
+    if (isQuarantinedApp(QString::fromStdString(desc->id())))
+        return QString::fromStdString(desc->id());
+
     QString key;
     QStringList idList, trustLevelList;
     if (m_maximumNumberOfProcesses == 1)
@@ -242,18 +303,625 @@ void WebProcessManager::killWebProcess(uint32_t pid)
     }
 
     LOG_INFO(MSGID_KILL_WEBPROCESS, 1, PMLOGKFV("PID", "%u", pid), "");
-    int ret = kill(pid, SIGKILL);
-    if (ret == -1)
+    bool killed = m_webProcessWatchMap.contains(pid) ? signalWebProcess(pid, SIGKILL) : kill(pid, SIGKILL) != -1;
+    if (!killed)
         LOG_ERROR(MSGID_KILL_WEBPROCESS_FAILED, 1, PMLOGKS("ERROR", strerror(errno)), "SystemCall failed");
 }
 
 void WebProcessManager::requestKillWebProcess(uint32_t pid)
 {
+    if (!pid || m_reclaimInfoMap.contains(pid))
+        return;
+
     for (QMap<QString, WebProcessInfo>::iterator it = m_webProcessInfoMap.begin(); it != m_webProcessInfoMap.end(); it++) {
         if (it.value().webProcessPid == pid) {
-            LOG_INFO(MSGID_KILL_WEBPROCESS_DELAYED, 1, PMLOGKFV("PID", "%u", pid), "");
             it.value().requestKill = true;
+            break;
+        }
+    }
+
+    if (isWebProcessForeground(pid)) {
+        LOG_INFO(MSGID_KILL_WEBPROCESS_DELAYED, 1, PMLOGKFV("PID", "%u", pid), "Foreground app is running; wait until it goes to background");
+        if (!m_deferredReclaimPids.contains(pid))
+            m_deferredReclaimPids.append(pid);
+        return;
+    }
+
+    startReclaimWebProcess(pid);
+}
+
+void WebProcessManager::webAppDeactivated(const WebAppBase* app)
+{
+    uint32_t pid = getWebProcessPID(app);
+    if (!m_deferredReclaimPids.contains(pid) || isWebProcessForeground(pid, app))
+        return;
+
+    m_deferredReclaimPids.removeAll(pid);
+    startReclaimWebProcess(pid);
+}
+
+bool WebProcessManager::isWebProcessForeground(uint32_t pid, const WebAppBase* except)
+{
+    std::list<const WebAppBase*> apps = runningApps(pid);
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        if (*it != except && (*it)->isActivated() && !(*it)->getHiddenWindow())
+            return true;
+    }
+
+    return false;
+}
+
+const char* WebProcessManager::oomStateName(OomState state)
+{
+    switch (state) {
+    case OomStateForeground:
+        return "foreground";
+    case OomStateVisibleOverlay:
+        return "overlay";
+    case OomStateBackground:
+        return "background";
+    case OomStateKeepAlive:
+        return "keepAlive";
+    case OomStatePreload:
+        return "preload";
+    case OomStateSpareContainer:
+        return "container";
+    default:
+        return "none";
+    }
+}
+
+WebProcessManager::OomState WebProcessManager::oomStateForWebProcess(uint32_t pid)
+{
+    // A shared renderer is as important as the most important app it hosts
+    OomState state = OomStateNone;
+    std::list<const WebAppBase*> apps = runningApps(pid);
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = findAppById((*it)->appId());
+        if (!app)
+            continue;
+
+        OomState appState;
+        if (app->isActivated() && !app->getHiddenWindow())
+            appState = app->getAppDescription()->defaultWindowType() == "overlay" ? OomStateVisibleOverlay : OomStateForeground;
+        else if (app->preloadState() != WebAppBase::NONE_PRELOAD)
+            appState = OomStatePreload;
+        else if (app->keepAlive())
+            appState = OomStateKeepAlive;
+        else
+            appState = OomStateBackground;
+
+        if (state == OomStateNone || appState < state)
+            state = appState;
+    }
+
+    WebAppBase* container = getContainerApp();
+    if (state == OomStateNone && container && container->page() && container->page()->getWebProcessPID() == pid)
+        state = OomStateSpareContainer;
+
+    return state;
+}
+
+void WebProcessManager::updateWebProcessPriority(uint32_t pid)
+{
+    if (!pid)
+        return;
+
+    OomState state = oomStateForWebProcess(pid);
+    if (state == OomStateNone)
+        return;
+
+    updateOomScoreAdj(pid, state);
+    updateIoPriority(pid, state);
+    updateCpuAffinity(pid, state <= OomStateVisibleOverlay || isWebProcessLaunching(pid));
+}
+
+void WebProcessManager::updateOomScoreAdj(uint32_t pid, OomState state)
+{
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    if (!config->isOomScoreAdjEnabled())
+        return;
+
+    int value = config->getOomScoreAdj(QLatin1String(oomStateName(state)), kDefaultOomScoreAdj[state]);
+    if (m_oomScoreAdjMap.contains(pid) && m_oomScoreAdjMap.value(pid) == value)
+        return;
+
+    QString path = QString("%1/%2/oom_score_adj").arg(config->getProcRoot()).arg(pid);
+    QFile file(path);
+    QByteArray data = QByteArray::number(value);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        LOG_WARNING(MSGID_OOM_SCORE_ADJ, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("PATH", qPrintable(path)), "Fail to write oom_score_adj");
+        return;
+    }
+
+    m_oomScoreAdjMap[pid] = value;
+    LOG_INFO(MSGID_OOM_SCORE_ADJ, 3, PMLOGKFV("PID", "%u", pid), PMLOGKS("STATE", oomStateName(state)), PMLOGKFV("OOM_SCORE_ADJ", "%d", value), "");
+}
+
+void WebProcessManager::updateIoPriority(uint32_t pid, OomState state)
+{
+    if (!WebAppManager::instance()->config()->isIoPriorityEnabled())
+        return;
+
+    // Visible apps load at high best-effort priority, hidden ones only use idle disk time
+    int priority = state <= OomStateVisibleOverlay
+        ? WebAppManagerUtils::ioPriority(WebAppManagerUtils::IoPriorityClassBestEffort, 0)
+        : WebAppManagerUtils::ioPriority(WebAppManagerUtils::IoPriorityClassIdle, 0);
+    if (m_ioPriorityMap.contains(pid) && m_ioPriorityMap.value(pid) == priority)
+        return;
+
+    // Threads started later inherit the priority of their creator
+    if (!WebAppManagerUtils::setProcessIoPriority(pid, priority)) {
+        LOG_WARNING(MSGID_IO_PRIORITY, 1, PMLOGKFV("PID", "%u", pid), "Fail to set I/O priority");
+        return;
+    }
+
+    m_ioPriorityMap[pid] = priority;
+    LOG_INFO(MSGID_IO_PRIORITY, 3, PMLOGKFV("PID", "%u", pid), PMLOGKS("STATE", oomStateName(state)), PMLOGKFV("IOPRIO", "%d", priority), "");
+}
+
+bool WebProcessManager::isWebProcessLaunching(uint32_t pid)
+{
+    // Apps launched to be shown count as foreground until their first show
+    std::list<const WebAppBase*> apps = runningApps(pid);
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        WebAppBase* app = findAppById((*it)->appId());
+        if (app && app->page() && app->preloadState() == WebAppBase::NONE_PRELOAD && !app->page()->hasBeenShown())
+            return true;
+    }
+
+    return false;
+}
+
+void WebProcessManager::readCpuTopology()
+{
+    m_cpuTopologyRead = true;
+
+    QDir cpuDir(WebAppManager::instance()->config()->getSysfsRoot() + QLatin1String("/devices/system/cpu"));
+    QStringList cpuNames = cpuDir.entryList(QStringList() << QLatin1String("cpu[0-9]*"), QDir::Dirs);
+
+    QMap<int, int> capacityMap;
+    int maxCapacity = 0;
+    Q_FOREACH (const QString& cpuName, cpuNames) {
+        bool ok = false;
+        int cpu = cpuName.mid(3).toInt(&ok);
+        QFile file(cpuDir.filePath(cpuName + QLatin1String("/cpu_capacity")));
+        if (!ok || !file.open(QIODevice::ReadOnly))
+            continue;
+
+        int capacity = file.readAll().trimmed().toInt();
+        if (capacity <= 0)
+            continue;
+
+        capacityMap.insert(cpu, capacity);
+        maxCapacity = std::max(maxCapacity, capacity);
+    }
+
+    for (QMap<int, int>::const_iterator it = capacityMap.begin(); it != capacityMap.end(); ++it) {
+        if (it.value() == maxCapacity)
+            m_bigCpus.push_back(it.key());
+        else
+            m_littleCpus.push_back(it.key());
+    }
+
+    // Symmetric cores leave placement to the scheduler
+    if (m_littleCpus.empty())
+        m_bigCpus.clear();
+
+    LOG_INFO(MSGID_CPU_AFFINITY, 2, PMLOGKFV("BIG_CPUS", "%d", static_cast<int>(m_bigCpus.size())),
+        PMLOGKFV("LITTLE_CPUS", "%d", static_cast<int>(m_littleCpus.size())), "CPU topology");
+}
+
+void WebProcessManager::updateCpuAffinity(uint32_t pid, bool bigCores)
+{
+    if (!WebAppManager::instance()->config()->isCpuAffinityEnabled())
+        return;
+
+    if (!m_cpuTopologyRead)
+        readCpuTopology();
+
+    if (m_bigCpus.empty() || (m_cpuAffinityMap.contains(pid) && m_cpuAffinityMap.value(pid) == bigCores))
+        return;
+
+    if (!WebAppManagerUtils::setProcessCpuAffinity(pid, bigCores ? m_bigCpus : m_littleCpus)) {
+        LOG_WARNING(MSGID_CPU_AFFINITY, 1, PMLOGKFV("PID", "%u", pid), "Fail to set CPU affinity");
+        return;
+    }
+
+    m_cpuAffinityMap[pid] = bigCores;
+    LOG_INFO(MSGID_CPU_AFFINITY, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("CORES", bigCores ? "big" : "little"), "");
+}
+
+const char* WebProcessManager::reclaimStageName(ReclaimStage stage)
+{
+    switch (stage) {
+    case ReclaimStageMemoryPressure:
+        return "memoryPressure";
+    case ReclaimStagePageOut:
+        return "pageOut";
+    case ReclaimStageTerminate:
+        return "terminate";
+    case ReclaimStageKill:
+        return "kill";
+    default:
+        return "unknown";
+    }
+}
+
+void WebProcessManager::startReclaimWebProcess(uint32_t pid)
+{
+    uint32_t memSize = getWebProcessMemSizeInKB(pid);
+    if (!memSize)
+        return;
+
+    LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 2, PMLOGKFV("PID", "%u", pid), PMLOGKFV("MEM_SIZE_KB", "%u", memSize), "Start");
+
+    m_reclaimInfoMap.insert(pid, ReclaimInfo(memSize));
+    if (!enterReclaimStage(pid)) {
+        m_reclaimInfoMap.remove(pid);
+        return;
+    }
+
+    if (!m_reclaimTimer.isRunning())
+        m_reclaimTimer.start(kReclaimPollIntervalMs, this, &WebProcessManager::reclaimTimeout);
+}
+
+bool WebProcessManager::enterReclaimStage(uint32_t pid)
+{
+    ReclaimInfo& info = m_reclaimInfoMap[pid];
+    WebAppManagerConfig* config = WebAppManager::instance()->config();
+    qint64 now = g_get_monotonic_time();
+
+    switch (info.stage) {
+    case ReclaimStageMemoryPressure: {
+        std::list<const WebAppBase*> apps = runningApps(pid);
+        for (auto it = apps.begin(); it != apps.end(); ++it)
+            (*it)->page()->notifyMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+        info.deadline = now + static_cast<qint64>(config->getReclaimStageInterval()) * 1000;
+        return true;
+    }
+    case ReclaimStagePageOut:
+        if (!WebAppManagerUtils::pageOutProcessMemory(pid)) {
+            LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 1, PMLOGKFV("PID", "%u", pid), "process_madvise is not available; skip pageOut");
+            info.stage = ReclaimStageTerminate;
+            return enterReclaimStage(pid);
+        }
+        info.deadline = now + static_cast<qint64>(config->getReclaimStageInterval()) * 1000;
+        return true;
+    case ReclaimStageTerminate: {
+        // Renderer exit is not a crash of the hosted apps
+        std::list<const WebAppBase*> apps = runningApps(pid);
+        for (auto it = apps.begin(); it != apps.end(); ++it)
+            m_reclaimedAppIds.append((*it)->appId());
+
+        LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 1, PMLOGKFV("PID", "%u", pid), "Send SIGTERM");
+        if (!signalWebProcess(pid, SIGTERM)) {
+            // The renderer has already exited, nothing is left to kill
+            if (errno == ESRCH)
+                return false;
+            LOG_ERROR(MSGID_KILL_WEBPROCESS_FAILED, 1, PMLOGKS("ERROR", strerror(errno)), "SystemCall failed");
+            info.stage = ReclaimStageKill;
+            return enterReclaimStage(pid);
+        }
+        info.deadline = now + static_cast<qint64>(config->getReclaimTerminateTimeout()) * 1000;
+        return true;
+    }
+    case ReclaimStageKill:
+        m_reclaimedMemSize[ReclaimStageKill] += info.stageMemSize;
+        LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 4, PMLOGKFV("PID", "%u", pid),
+            PMLOGKS("STAGE", reclaimStageName(info.stage)),
+            PMLOGKFV("RECOVERED_KB", "%u", info.stageMemSize),
+            PMLOGKFV("STAGE_TOTAL_KB", "%llu", (unsigned long long)m_reclaimedMemSize[ReclaimStageKill]), "");
+        // Seconds have passed since the stage began, the pid alone may name another process by now
+        if (m_webProcessWatchMap.contains(pid))
+            killWebProcess(pid);
+        return false;
+    default:
+        return false;
+    }
+}
+
+bool WebProcessManager::signalWebProcess(uint32_t pid, int sig)
+{
+    // The pidfd keeps naming the renderer even after its pid is reused
+    QMap<uint32_t, WebProcessWatch>::const_iterator it = m_webProcessWatchMap.find(pid);
+    if (it == m_webProcessWatchMap.end()) {
+        errno = ESRCH;
+        return false;
+    }
+
+    return WebAppManagerUtils::sendPidFdSignal(it.value().pidfd, sig) != -1;
+}
+
+void WebProcessManager::reclaimTimeout()
+{
+    qint64 now = g_get_monotonic_time();
+    uint32_t target = WebAppManager::instance()->config()->getReclaimTarget() * 1024;
+
+    QList<uint32_t> pids = m_reclaimInfoMap.keys();
+    Q_FOREACH (uint32_t pid, pids) {
+        ReclaimInfo& info = m_reclaimInfoMap[pid];
+
+        // VmRSS can not be read any more once the process has exited
+        uint32_t memSize = getWebProcessMemSizeInKB(pid);
+        if (memSize && now < info.deadline)
+            continue;
+
+        uint32_t recovered = info.stageMemSize > memSize ? info.stageMemSize - memSize : 0;
+        m_reclaimedMemSize[info.stage] += recovered;
+        LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 4, PMLOGKFV("PID", "%u", pid),
+            PMLOGKS("STAGE", reclaimStageName(info.stage)),
+            PMLOGKFV("RECOVERED_KB", "%u", recovered),
+            PMLOGKFV("STAGE_TOTAL_KB", "%llu", (unsigned long long)m_reclaimedMemSize[info.stage]), "");
+
+        bool finished = !memSize || (target && info.startMemSize > memSize && info.startMemSize - memSize >= target);
+        if (!finished) {
+            info.stage = static_cast<ReclaimStage>(info.stage + 1);
+            info.stageMemSize = memSize;
+            finished = !enterReclaimStage(pid);
+        }
+
+        if (finished) {
+            LOG_INFO(MSGID_WEBPROCESS_RECLAIM, 2, PMLOGKFV("PID", "%u", pid),
+                PMLOGKFV("MEM_SIZE_KB", "%u", memSize), "Finished");
+            m_reclaimInfoMap.remove(pid);
+        }
+    }
+
+    if (m_reclaimInfoMap.isEmpty())
+        m_reclaimTimer.stop();
+}
+
+uint32_t WebProcessManager::getWebProcessMemSizeInKB(uint32_t pid) const
+{
+    if (!pid)
+        return 0;
+
+    // VmRSS is reported as "<size> kB"
+    return getWebProcessMemSize(pid).section(' ', 0, 0).toUInt();
+}
+
+QStringList WebProcessManager::webProcessPeers(const QString& appId, uint32_t pid)
+{
+    // Apps last seen on the renderer, either still running or having reported its crash already
+    QStringList peers;
+    std::list<const WebAppBase*> apps = runningApps();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        QMap<QString, AppHealthInfo>::const_iterator info = m_appHealthInfoMap.find((*it)->appId());
+        if (info != m_appHealthInfoMap.end() && info.key() != appId && info.value().pid == pid)
+            peers.append(info.key());
+    }
+    for (QMap<QString, AppHealthInfo>::const_iterator it = m_appHealthInfoMap.begin(); it != m_appHealthInfoMap.end(); ++it) {
+        if (it.key() != appId && it.value().lastCrashPid == pid && !peers.contains(it.key()))
+            peers.append(it.key());
+    }
+    return peers;
+}
+
+bool WebProcessManager::appCrashed(const QString& appId)
+{
+    if (m_reclaimedAppIds.removeAll(appId))
+        return false;
+
+    AppHealthInfo& info = m_appHealthInfoMap[appId];
+    if (!info.pid)
+        return true;
+
+    qint64 now = g_get_monotonic_time();
+    if (info.crashCount) {
+        qint64 periods = (now - info.lastCrashTime) / kCrashDecayPeriodUs;
+        info.crashCount = periods >= 32 ? 0 : info.crashCount >> periods;
+        if (!info.crashCount)
+            info.crashPeers.clear();
+    }
+
+    // Every app of a crashed renderer reports it, the one crashing with
+    // changing neighbours is charged while its neighbours are cleared
+    QStringList peers = webProcessPeers(appId, info.pid);
+    info.lastCrashPid = info.pid;
+    if (!chargeIncident(info.crashCount, info.crashPeers, peers))
+        return true;
+    info.lastCrashTime = now;
+
+    uint32_t threshold = WebAppManager::instance()->config()->getQuarantineCrashThreshold();
+    if (threshold && info.crashCount >= threshold && info.crashPeers.isEmpty())
+        quarantineApp(appId, QStringLiteral("crash"));
+    return true;
+}
+
+void WebProcessManager::appClosed(const QString& appId)
+{
+    m_reclaimedAppIds.removeAll(appId);
+}
+
+void WebProcessManager::setAppMemoryBaseline(const QString& appId, uint32_t pid)
+{
+    m_reclaimedAppIds.removeAll(appId);
+
+    AppHealthInfo& info = m_appHealthInfoMap[appId];
+    info.pid = pid;
+    info.baselineMemSize = getWebProcessMemSizeInKB(pid);
+    info.peakMemGrowth = 0;
+    info.growthCharged = false;
+}
+
+void WebProcessManager::updateAppMemoryUsage(const QString& appId, uint32_t pid)
+{
+    QMap<QString, AppHealthInfo>::iterator it = m_appHealthInfoMap.find(appId);
+    if (it == m_appHealthInfoMap.end() || !it.value().baselineMemSize)
+        return;
+
+    if (it.value().pid != pid)
+        return;
+
+    uint32_t memSize = getWebProcessMemSizeInKB(pid);
+    if (memSize <= it.value().baselineMemSize)
+        return;
+
+    uint32_t growth = memSize - it.value().baselineMemSize;
+    if (growth <= it.value().peakMemGrowth)
+        return;
+
+    it.value().peakMemGrowth = growth;
+
+    uint32_t threshold = WebAppManager::instance()->config()->getQuarantineMemoryGrowthThreshold();
+    if (!threshold || growth < threshold * 1024 || it.value().growthCharged)
+        return;
+
+    // VmRSS belongs to the whole renderer. Every app on it is charged, the one
+    // that grew it with different neighbours each time is the culprit
+    it.value().growthCharged = true;
+    QStringList peers;
+    std::list<const WebAppBase*> apps = runningApps(pid);
+    for (auto app = apps.begin(); app != apps.end(); ++app) {
+        if ((*app)->appId() != appId)
+            peers.append((*app)->appId());
+    }
+    if (chargeIncident(it.value().growthCount, it.value().growthPeers, peers) && it.value().growthPeers.isEmpty())
+        quarantineApp(appId, QStringLiteral("memory"));
+}
+
+bool WebProcessManager::isQuarantinedApp(const QString& appId) const
+{
+    QMap<QString, qint64>::const_iterator it = m_quarantinedApps.find(appId);
+    if (it == m_quarantinedApps.end())
+        return false;
+
+    return it.value() > QDateTime::currentMSecsSinceEpoch();
+}
+
+void WebProcessManager::quarantineApp(const QString& appId, const QString& reason)
+{
+    if (isQuarantinedApp(appId))
+        return;
+
+    qint64 expireTime = QDateTime::currentMSecsSinceEpoch()
+        + static_cast<qint64>(WebAppManager::instance()->config()->getQuarantineExpireTime()) * 1000;
+    m_quarantinedApps.insert(appId, expireTime);
+
+    const AppHealthInfo& info = m_appHealthInfoMap[appId];
+    LOG_INFO(MSGID_WEBPROCESS_QUARANTINE, 4, PMLOGKS("APP_ID", qPrintable(appId)),
+        PMLOGKS("REASON", qPrintable(reason)),
+        PMLOGKFV("CRASH_COUNT", "%u", info.crashCount),
+        PMLOGKFV("PEAK_MEM_GROWTH_KB", "%u", info.peakMemGrowth), "Use dedicated web process on next launch");
+
+    writeQuarantineList();
+}
+
+void WebProcessManager::readQuarantineList()
+{
+    QFile file(WebAppManager::instance()->config()->getQuarantineListPath());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QString jsonStr = file.readAll();
+    file.close();
+
+    QJsonDocument quarantineList = QJsonDocument::fromJson(jsonStr.toUtf8());
+    if (quarantineList.isNull()) {
+        LOG_ERROR(MSGID_WEBPROCESS_QUARANTINE_READ_FAIL, 1, PMLOGKS("CONTENT", jsonStr.toStdString().c_str()), "");
+        return;
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QJsonArray appArray = quarantineList.object().value("quarantinedApps").toArray();
+    Q_FOREACH (const QJsonValue &value, appArray) {
+        QJsonObject obj = value.toObject();
+        QString id = obj.value("id").toString();
+        qint64 expireTime = static_cast<qint64>(obj.value("expireTime").toDouble());
+        if (!id.isEmpty() && expireTime > now)
+            m_quarantinedApps.insert(id, expireTime);
+    }
+
+    // Drop expired entries from the stored list as well
+    if (m_quarantinedApps.size() != appArray.size())
+        writeQuarantineList();
+}
+
+void WebProcessManager::writeQuarantineList()
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QJsonArray appArray;
+    for (QMap<QString, qint64>::iterator it = m_quarantinedApps.begin(); it != m_quarantinedApps.end();) {
+        if (it.value() <= now) {
+            it = m_quarantinedApps.erase(it);
+            continue;
+        }
+
+        QJsonObject obj;
+        obj["id"] = it.key();
+        obj["expireTime"] = static_cast<double>(it.value());
+        appArray.append(obj);
+        ++it;
+    }
+
+    QJsonObject quarantineList;
+    quarantineList["quarantinedApps"] = appArray;
+
+    QString path = WebAppManager::instance()->config()->getQuarantineListPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        LOG_ERROR(MSGID_WEBPROCESS_QUARANTINE_WRITE_FAIL, 1, PMLOGKS("PATH", qPrintable(path)), "");
+        return;
+    }
+
+    file.write(QJsonDocument(quarantineList).toJson());
+    file.close();
+}
+
+void WebProcessManager::watchWebProcess(const QString& appId, uint32_t pid)
+{
+    if (!pid)
+        return;
+
+    QMap<uint32_t, WebProcessWatch>::iterator it = m_webProcessWatchMap.find(pid);
+    if (it == m_webProcessWatchMap.end()) {
+        int pidfd = WebAppManagerUtils::openPidFd(pid);
+        if (pidfd == -1) {
+            LOG_WARNING(MSGID_WEBPROCESS_WATCH_FAIL, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("ERROR", strerror(errno)), "");
             return;
         }
+
+        guint sourceId = g_unix_fd_add(pidfd, G_IO_IN, webProcessExitedCallback, GUINT_TO_POINTER(pid));
+        it = m_webProcessWatchMap.insert(pid, WebProcessWatch(pidfd, sourceId));
+    }
+
+    if (!it.value().appIds.contains(appId))
+        it.value().appIds.append(appId);
+}
+
+void WebProcessManager::webProcessExited(uint32_t pid)
+{
+    QMap<uint32_t, WebProcessWatch>::iterator it = m_webProcessWatchMap.find(pid);
+    if (it == m_webProcessWatchMap.end())
+        return;
+
+    // The GSource is removed by returning G_SOURCE_REMOVE from its callback
+    QList<QString> appIds = it.value().appIds;
+    close(it.value().pidfd);
+    m_webProcessWatchMap.erase(it);
+
+    LOG_INFO(MSGID_WEBPROCESS_EXITED, 2, PMLOGKFV("PID", "%u", pid), PMLOGKFV("APP_COUNT", "%d", appIds.size()), "");
+
+    for (QMap<QString, WebProcessInfo>::iterator info = m_webProcessInfoMap.begin(); info != m_webProcessInfoMap.end(); ++info) {
+        if (info.value().webProcessPid == pid) {
+            info.value().webProcessPid = 0;
+            info.value().proxyID = 0;
+            info.value().requestKill = false;
+        }
+    }
+    m_deferredReclaimPids.removeAll(pid);
+    m_oomScoreAdjMap.remove(pid);
+    m_ioPriorityMap.remove(pid);
+    m_cpuAffinityMap.remove(pid);
+    WebAppManager::instance()->getCgroupManager()->webProcessExited(pid);
+
+    // Recovery may close and delete apps, so look each one up again
+    Q_FOREACH (const QString& appId, appIds) {
+        WebAppBase* app = findAppById(appId);
+        if (app && app->page())
+            app->page()->webProcessExited(pid);
     }
 }
@@ -18,20 +18,26 @@
 #define WEBPROCESSMANAGER_H
 
 #include <list>
+#include <vector>
 
 #include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QString>
+#include <QStringList>
+
+#include "Timer.h"
 
 class ApplicationDescription;
 class WebPageBase;
 class WebAppBase;
 
 class WebProcessManager {
+    friend class WebProcessManagerTest;
+
 public:
     WebProcessManager();
-    virtual ~WebProcessManager() {}
+    virtual ~WebProcessManager();
 
     uint32_t getWebProcessProxyID(const ApplicationDescription* desc) const;
     uint32_t getWebProcessProxyID(uint32_t pid) const;
@@ -43,6 +49,25 @@ public:
     void readWebProcessPolicy(); //chane name from setWebProcessEnvironment()
     QString getProcessKey(const ApplicationDescription* desc) const; //change name from getKey()
 
+    // Apps that crash or grow a renderer they share with others are moved to
+    // a dedicated web process on next launch, out of the container on Blink.
+    // Returns false when the renderer was terminated by the reclaim engine
+    bool appCrashed(const QString& appId);
+    void appClosed(const QString& appId);
+    void setAppMemoryBaseline(const QString& appId, uint32_t pid);
+    void updateAppMemoryUsage(const QString& appId, uint32_t pid);
+    bool isQuarantinedApp(const QString& appId) const;
+
+    // Deferred kill requests are started once no app on the process is foreground
+    void webAppDeactivated(const WebAppBase* app);
+
+    void watchWebProcess(const QString& appId, uint32_t pid);
+    void webProcessExited(uint32_t pid);
+
+    // Sets oom_score_adj, I/O priority and CPU affinity of the renderer from
+    // the most important app state it hosts
+    void updateWebProcessPriority(uint32_t pid);
+
     virtual QJsonObject getWebProcessProfiling() = 0;
     virtual uint32_t getWebProcessPID(const WebAppBase* app) const = 0;
     virtual void deleteStorageData(const QString& identifier) = 0;
@@ -54,7 +79,48 @@ protected:
     std::list<const WebAppBase*> runningApps();
     std::list<const WebAppBase*> runningApps(uint32_t pid);
     WebAppBase* findAppById(const QString& appId);
-    WebAppBase* getContainerApp();
+    virtual WebAppBase* getContainerApp();
+
+private:
+    uint32_t getWebProcessMemSizeInKB(uint32_t pid) const;
+    void quarantineApp(const QString& appId, const QString& reason);
+    QStringList webProcessPeers(const QString& appId, uint32_t pid);
+    void readQuarantineList();
+    void writeQuarantineList();
+
+    enum ReclaimStage {
+        ReclaimStageMemoryPressure = 0,
+        ReclaimStagePageOut,
+        ReclaimStageTerminate,
+        ReclaimStageKill,
+        ReclaimStageCount
+    };
+    static const char* reclaimStageName(ReclaimStage stage);
+
+    bool isWebProcessForeground(uint32_t pid, const WebAppBase* except = 0);
+
+    // Ordered from the last to the first the OOM killer should pick
+    enum OomState {
+        OomStateNone = -1,
+        OomStateForeground = 0,
+        OomStateVisibleOverlay,
+        OomStateBackground,
+        OomStateKeepAlive,
+        OomStatePreload,
+        OomStateSpareContainer,
+        OomStateCount
+    };
+    static const char* oomStateName(OomState state);
+    OomState oomStateForWebProcess(uint32_t pid);
+    void updateOomScoreAdj(uint32_t pid, OomState state);
+    void updateIoPriority(uint32_t pid, OomState state);
+    bool isWebProcessLaunching(uint32_t pid);
+    void readCpuTopology();
+    void updateCpuAffinity(uint32_t pid, bool bigCores);
+    void startReclaimWebProcess(uint32_t pid);
+    bool enterReclaimStage(uint32_t pid);
+    bool signalWebProcess(uint32_t pid, int sig);
+    void reclaimTimeout();
 
 protected:
     class WebProcessInfo {
@@ -87,6 +153,83 @@ protected:
     uint32_t m_maximumNumberOfProcesses;
     QList<QString> m_webProcessGroupAppIDList;
     QList<QString> m_webProcessGroupTrustLevelList;
+
+    class AppHealthInfo {
+    public:
+        AppHealthInfo()
+            : crashCount(0)
+            , lastCrashTime(0)
+            , lastCrashPid(0)
+            , growthCount(0)
+            , pid(0)
+            , baselineMemSize(0)
+            , peakMemGrowth(0)
+            , growthCharged(false)
+        {
+        }
+
+        // Only incidents on a shared renderer are charged. The peers are the
+        // apps present at every charged incident, none left means the app is
+        // the one thing all of them had in common
+        uint32_t crashCount; // halved for every decay period without a crash
+        qint64 lastCrashTime; // monotonic usecs
+        uint32_t lastCrashPid;
+        QStringList crashPeers;
+        uint32_t growthCount;
+        QStringList growthPeers;
+
+        uint32_t pid; // last renderer of the app
+        uint32_t baselineMemSize; // KB, renderer VmRSS when the app joined it
+        uint32_t peakMemGrowth; // KB
+        bool growthCharged; // once per stay on a renderer
+    };
+    QMap<QString, AppHealthInfo> m_appHealthInfoMap;
+
+    // appId -> expire time (msecs since epoch)
+    QMap<QString, qint64> m_quarantinedApps;
+
+    class ReclaimInfo {
+    public:
+        ReclaimInfo(uint32_t memSize = 0)
+            : stage(ReclaimStageMemoryPressure)
+            , startMemSize(memSize)
+            , stageMemSize(memSize)
+            , deadline(0)
+        {
+        }
+
+        ReclaimStage stage;
+        uint32_t startMemSize; // KB
+        uint32_t stageMemSize; // KB
+        qint64 deadline; // monotonic usecs
+    };
+    QMap<uint32_t, ReclaimInfo> m_reclaimInfoMap;
+    QList<uint32_t> m_deferredReclaimPids;
+    QList<QString> m_reclaimedAppIds;
+    uint64_t m_reclaimedMemSize[ReclaimStageCount]; // KB, accumulated per stage
+    RepeatingTimer<WebProcessManager> m_reclaimTimer;
+
+    class WebProcessWatch {
+    public:
+        WebProcessWatch(int fd = -1, unsigned int id = 0)
+            : pidfd(fd)
+            , sourceId(id)
+        {
+        }
+
+        int pidfd;
+        unsigned int sourceId;
+        QList<QString> appIds;
+    };
+    QMap<uint32_t, WebProcessWatch> m_webProcessWatchMap;
+
+    QMap<uint32_t, int> m_oomScoreAdjMap; // last value written per renderer
+    QMap<uint32_t, int> m_ioPriorityMap; // last ioprio set per renderer
+
+    bool m_cpuTopologyRead;
+    std::vector<int> m_bigCpus; // highest cpu_capacity
+    std::vector<int> m_littleCpus;
+    QMap<uint32_t, bool> m_cpuAffinityMap; // true when pinned to big cores
 };
 
 #endif /* WEBPROCESSMANAGER_H */
@@ -20,9 +20,14 @@
 #include <QtCore/QJsonArray>
 
 #include "ApplicationDescription.h"
+#include "CgroupManager.h"
+#include "ExclusiveModeManager.h"
+#include "KeepAliveTrimmer.h"
 #include "LogManager.h"
+#include "WebAppManager.h"
 #include "WebAppWaylandWindow.h"
 #include "WebPageBase.h"
+#include "WebProcessManager.h"
 #include "WindowTypes.h"
 
 #include "webos/common/webos_constants.h"
@@ -110,6 +115,10 @@ void WebAppWayland::startLaunchTimer()
 
 void WebAppWayland::onDelegateWindowFrameSwapped()
 {
+    // Restores end at the first frame, like the cold launches they are compared with
+    restoreFinished();
+    WebAppManager::instance()->appFrameSwapped(appId());
+
     if(m_elapsedLaunchTimer.isRunning()) {
         m_lastSwappedTime = m_elapsedLaunchTimer.elapsed_ms();
 
@@ -206,11 +215,22 @@ void WebAppWayland::onStageActivated()
         setCrashState(false);
     }
 
+    // Thaw first so the renderer can act on the restore and resume at once
+    WebAppManager::instance()->getCgroupManager()->thawWebProcess(page()->getWebProcessPID());
+
+    if (isDiscarded())
+        restore();
+
     page()->resumeWebPageAll();
 
     page()->setVisibilityState(WebPageBase::WebPageVisibilityState::WebPageVisibilityStateVisible);
 
     setActiveAppId(page()->getIdentifier());
+    WebAppManager::instance()->getCgroupManager()->appActivated(this);
+    WebAppManager::instance()->getKeepAliveTrimmer()->appShown(appId());
+    WebAppManager::instance()->getExclusiveModeManager()->appActivated(this);
+    if (WebAppManager::instance()->getWebProcessManager())
+        WebAppManager::instance()->getWebProcessManager()->updateWebProcessPriority(page()->getWebProcessPID());
     focus();
 
     if (getHiddenWindow() || keepAlive())
@@ -226,6 +246,13 @@ void WebAppWayland::onStageDeactivated()
     page()->setVisibilityState(WebPageBase::WebPageVisibilityState::WebPageVisibilityStateHidden);
     page()->suspendWebPageAll();
 
+    if (WebAppManager::instance()->getWebProcessManager()) {
+        WebAppManager::instance()->getWebProcessManager()->webAppDeactivated(this);
+        WebAppManager::instance()->getWebProcessManager()->updateWebProcessPriority(page()->getWebProcessPID());
+    }
+    WebAppManager::instance()->getCgroupManager()->appDeactivated(this);
+    WebAppManager::instance()->getExclusiveModeManager()->appDeactivated(appId());
+
     LOG_INFO(MSGID_WEBAPP_STAGE_DEACITVATED, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", page()->getWebProcessPID()), "");
 }
 
@@ -530,9 +557,13 @@ void WebAppWayland::doClose()
         deleteSurfaceGroup();
         setHiddenWindow(true);
         m_addedToWindowMgr = false;
+        WebAppManager::instance()->getKeepAliveTrimmer()->appHidden(this);
         return;
     }
 
+    if (WebAppManager::instance()->deferCloseApp(this))
+        return;
+
     LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", page()->getWebProcessPID()), "WebAppWayland::doClose(); call closeAppInternal()");
     closeAppInternal();
 }
@@ -660,8 +691,11 @@ void WebAppWayland::deleteSurfaceGroup()
 void WebAppWayland::setKeepAlive(bool keepAlive)
 {
     WebAppBase::setKeepAlive(keepAlive);
-    if (page())
+    if (page()) {
         page()->setKeepAliveWebApp(keepAlive);
+        if (WebAppManager::instance()->getWebProcessManager())
+            WebAppManager::instance()->getWebProcessManager()->updateWebProcessPriority(page()->getWebProcessPID());
+    }
 }
 
 void WebAppWayland::moveInputRegion(int height)
@@ -24,6 +24,8 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QDataStream>
 
+static const int kMaxRestoreStateSize = 4096;
+
 PalmSystemBlink::PalmSystemBlink(WebAppBase* app)
     : PalmSystemWebOS(app)
 {
@@ -83,6 +85,14 @@ QString PalmSystemBlink::handleBrowserControlMessage(const QString& message, con
     } else if (message == "keepAlive") {
         if (params.size() > 0)
             setKeepAlive(params[0] == "true");
+    } else if (message == "setRestoreState") {
+        // Small blob handed back in webOSRestore after the app was discarded
+        if (params.size() > 0 && params[0].size() <= kMaxRestoreStateSize)
+            m_app->setRestoreState(params[0]);
+    } else if (message == "setMemoryPressureListener") {
+        // Apps that do not opt in are never woken for webOSMemoryPressure
+        if (params.size() > 0)
+            m_app->page()->setMemoryPressureListener(params[0] == "true");
     } else if (message == "PmLogInfoWithClock") {
         if (params.size() == 3)
             pmLogInfoWithClock(params[0], params[1], params[2]);
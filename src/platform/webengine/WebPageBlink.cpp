@@ -19,6 +19,8 @@
 #include <cmath>
 
 #include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMultiMap>
 #include <QtCore/QUrl>
 #include <QtCore/QUrlQuery>
@@ -87,6 +89,9 @@ WebPageBlink::WebPageBlink(const QUrl& url, ApplicationDescription* desc, const
     , m_vkbWasOverlap(false)
     , m_hasCloseCallback(false)
     , m_trustLevel(QString::fromStdString(desc->trustLevel()))
+    , m_renderProcessPid(0)
+    , m_backgroundThrottleReasons(0)
+    , m_hasPendingRestore(false)
 {
 }
 
@@ -433,10 +438,11 @@ void WebPageBlink::suspendWebPageAll()
 
     m_isSuspended = true;
     if (shouldStopJSOnSuspend()) {
-        m_domSuspendTimer.start(suspendDelay(), this,
+        int delay = suspendDelay();
+        m_domSuspendTimer.start(delay, this,
                             &WebPageBlink::suspendWebPagePaintingAndJSExecution);
+        LOG_INFO(MSGID_SUSPEND_WEBPAGE, 3, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), PMLOGKFV("DELAY", "%dms", delay), "DomSuspendTimer Started");
     }
-    LOG_INFO(MSGID_SUSPEND_WEBPAGE, 3, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), PMLOGKFV("DELAY", "%dms", suspendDelay()), "DomSuspendTimer Started");
 }
 
 void WebPageBlink::resumeWebPageAll()
@@ -446,11 +452,49 @@ void WebPageBlink::resumeWebPageAll()
     // Resume DOM and JS Excution
     // set visibility : visible (dispatch visibilitychange event)
     // set send to plugin about this visibility change
+    applyBackgroundThrottle(0);
     if (shouldStopJSOnSuspend()) {
         resumeWebPagePaintingAndJSExecution();
     }
     resumeWebPageMedia();
     d->pageView->SetVisible(true);
+    flushMemoryPressureEvent();
+}
+
+void WebPageBlink::setBackgroundThrottled(BackgroundThrottleReason reason, bool throttled)
+{
+    if (throttled)
+        applyBackgroundThrottle(m_backgroundThrottleReasons | reason);
+    else
+        applyBackgroundThrottle(m_backgroundThrottleReasons & ~reason);
+}
+
+void WebPageBlink::applyBackgroundThrottle(unsigned reasons)
+{
+    // suspendWebPagePaintingAndJSExecution() leaves background run pages
+    // alone, so throttling drives the DOM of the view directly
+    bool wasThrottled = m_backgroundThrottleReasons;
+    m_backgroundThrottleReasons = reasons;
+    if (wasThrottled == !!reasons)
+        return;
+
+    // DOM of a suspended page is handled by suspend and resume
+    if (m_isSuspended)
+        return;
+
+    if (reasons) {
+        d->pageView->SuspendWebPageDOM();
+    } else {
+        d->pageView->ResumeWebPageDOM();
+        flushMemoryPressureEvent();
+    }
+}
+
+void WebPageBlink::flushSuspendDelay()
+{
+    // Suspends DOM and JS of a hidden page now instead of when the delay expires
+    if (m_domSuspendTimer.isRunning())
+        suspendWebPagePaintingAndJSExecution();
 }
 
 void WebPageBlink::suspendWebPageMedia()
@@ -516,6 +560,7 @@ void WebPageBlink::resumeWebPagePaintingAndJSExecution()
     LOG_INFO(MSGID_RESUME_WEBPAGE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "%s; m_isSuspended : %s ", __func__, m_isSuspended ? "true" : "false; nothing to resume");
     m_suspendAtLoad = false;
     if (m_isSuspended) {
+        resumedFromSuspend();
         if (m_domSuspendTimer.isRunning()) {
             LOG_INFO(MSGID_SUSPEND_WEBPAGE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "DomSuspendTimer canceled by Resume");
             m_domSuspendTimer.stop();
@@ -649,6 +694,9 @@ void WebPageBlink::loadFinished(const std::string& url)
         return;
     }
     handleLoadFinished();
+
+    if (m_hasPendingRestore)
+        dispatchRestoreEvent();
 }
 
 void WebPageBlink::loadStarted()
@@ -690,6 +738,7 @@ void WebPageBlink::loadVisuallyCommitted()
 
 void WebPageBlink::renderProcessCreated(int pid)
 {
+    m_renderProcessPid = pid;
     postWebProcessCreated(pid);
 }
 
@@ -711,6 +760,8 @@ void WebPageBlink::forwardEvent(void* event)
 void WebPageBlink::recreateWebView()
 {
     LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "recreateWebView; initialize WebPage");
+    m_renderProcessPid = 0;
+    m_backgroundThrottleReasons = 0;
     delete d->pageView;
     if(!m_customPluginPath.isEmpty()) {
         // check setCustomPluginIfNeeded logic
@@ -773,6 +824,58 @@ void WebPageBlink::renderProcessCrashed()
         handleForceDeleteWebPage();
 }
 
+void WebPageBlink::webProcessExited(uint32_t pid)
+{
+    // Exit of the renderer can be noticed before the engine reports the crash.
+    // Once the view is recreated the old pid does not match anymore.
+    if (!m_renderProcessPid || m_renderProcessPid != pid)
+        return;
+
+    LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%u", pid), "Renderer exited");
+    renderProcessCrashed();
+}
+
+bool WebPageBlink::discardWebView()
+{
+    if (isClosing())
+        return false;
+
+    // Drop the document and its renderer and keep an empty view,
+    // the document is loaded again by restoreWebView()
+    LOG_INFO(MSGID_APP_EVICTION, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "Discard web view");
+    d->m_palmSystem->setInitialized(false);
+    recreateWebView();
+    return true;
+}
+
+void WebPageBlink::restoreWebView(const QUrl& url, const QString& state)
+{
+    // Fired once by loadFinished(), a later reload must not see the stale state
+    m_hasPendingRestore = true;
+    m_pendingRestoreState = state;
+
+    if (url.isEmpty() || url.toString() == "about:blank")
+        loadDefaultUrl();
+    else
+        loadUrl(url.toString().toStdString());
+}
+
+void WebPageBlink::dispatchRestoreEvent()
+{
+    QJsonObject detail;
+    detail["state"] = m_pendingRestoreState;
+    QString restoreEventJS = QStringLiteral(
+            "(function() {"
+            "    var restoreEvent = new CustomEvent('webOSRestore', { detail: %1 });"
+            "    document.dispatchEvent(restoreEvent);"
+            "})();"
+            ).arg(QString::fromUtf8(QJsonDocument(detail).toJson(QJsonDocument::Compact)));
+
+    m_hasPendingRestore = false;
+    m_pendingRestoreState.clear();
+    evaluateJavaScript(restoreEventJS);
+}
+
 void WebPageBlink::didFinishLaunchingSlot()
 {
 }
@@ -89,6 +89,11 @@ public:
     void deleteWebStorages(const QString& identfier) override;
     void setInspectorEnable() override;
     void setKeepAliveWebApp(bool keepAlive) override;
+    void webProcessExited(uint32_t pid) override;
+    bool discardWebView() override;
+    void restoreWebView(const QUrl& url, const QString& state) override;
+    void setBackgroundThrottled(BackgroundThrottleReason reason, bool throttled) override;
+    void flushSuspendDelay() override;
 
     // WebPageBlink
     virtual void loadExtension();
@@ -161,6 +166,7 @@ protected:
     virtual void recreateWebView();
     virtual void setVisible(bool visible);
     virtual bool shouldStopJSOnSuspend() const { return true; }
+    bool isJavaScriptSuspended() const override { return m_isSuspended || m_backgroundThrottleReasons; }
 
     bool inspectable();
 
@@ -177,6 +183,8 @@ protected Q_SLOTS:
 private:
     void setCustomPluginIfNeeded();
     void setDisallowScrolling(bool disallow);
+    void dispatchRestoreEvent();
+    void applyBackgroundThrottle(unsigned reasons);
 
 private:
     WebPageBlinkPrivate* d;
@@ -193,6 +201,11 @@ private:
     OneShotTimer<WebPageBlink> m_closeCallbackTimer;
     QString m_trustLevel;
     QString m_loadFailedHostname;
+    uint32_t m_renderProcessPid;
+    unsigned m_backgroundThrottleReasons;
+    // Saved state delivered by webOSRestore once the restored document loads
+    bool m_hasPendingRestore;
+    QString m_pendingRestoreState;
 };
 
 #endif /* WEBPAGEBLINK_H */
@@ -81,6 +81,7 @@
 #define MSGID_SETTING_SERVICE            "SETTING_SERVICE" /** Received a notification from setting service */
 #define MSGID_RECEIVED_INVALID_SETTINGS "RECEIVED_INVALID_SETTINGS" /** Received invalid value from systemservice */
 #define MSGID_APP_RELAUNCH              "APP_RELAUNCH" /** Sent when we get a request to launch an app that is already running */
+#define MSGID_APP_RESTORE               "APP_RESTORE" /** Discarded app is loaded again */
 #define MSGID_SERVICE_CONNECT_FAIL      "SERVICE_CONNECT_FAIL" /* Failed to connect to settingsservice */
 #define MSGID_DISPLAY_CONNECT_FAIL      "DISPLAY_CONNECT_FAIL" /* Failed to connect to display manager */
 #define MSGID_MEMORY_CONNECT_FAIL       "MEMORY_CONNECT_FAIL" /* Failed to connect to memory manager */
@@ -121,12 +122,37 @@
 #define MSGID_WEBPROCESSENV_READ_FAIL       "WEBPROCESSENV_FILE_READ_FAIL" /** Fail to read WebProcess environment setting from /etc/wam/com.webos.wam.json */
 #define MSGID_WEBPROCESS_INFO_ADDED         "WEBPROCESS_INFO_ADDED" /** New WebProcess info is added to WebProcess info map */
 #define MSGID_WEBPROCESS_PROXYID_SET        "WEBPROCESS_PROXYID_SET" /** WebProcess ProxyID is set from defalut value(0) */
+#define MSGID_WEBPROCESS_QUARANTINE         "WEBPROCESS_QUARANTINE" /** App is moved to a dedicated WebProcess on next launch */
+#define MSGID_WEBPROCESS_QUARANTINE_READ_FAIL "QUARANTINE_LIST_READ_FAIL" /** Fail to read stored quarantine list */
+#define MSGID_WEBPROCESS_QUARANTINE_WRITE_FAIL "QUARANTINE_LIST_WRITE_FAIL" /** Fail to store quarantine list */
+#define MSGID_WEBPROCESS_RECLAIM            "WEBPROCESS_RECLAIM" /** Staged memory reclamation of WebProcess */
+#define MSGID_WEBPROCESS_EXITED             "WEBPROCESS_EXITED" /** Watched WebProcess exited */
+#define MSGID_WEBPROCESS_WATCH_FAIL         "WEBPROCESS_WATCH_FAIL" /** Fail to watch WebProcess exit with pidfd */
+#define MSGID_APP_EVICTION                  "APP_EVICTION" /** Background app is trimmed, suspended, discarded or closed on memory pressure */
 #define MSGID_WEBPAGE_ADDED                 "WEBPAGE_ADDED" /** New web page is added to WebProcess info */
 #define MSGID_WEBPAGE_REMOVED               "WEBPAGE_REMOVED" /** Web page is removed from WebProcess info */
 
 #define MSGID_EXECUTE_CLOSECALLBACK         "EXECUTE_CLOSECALLBACK" /** Execute close callback */
 #define MSGID_CLEANRESOURCE_COMPLETED       "CLEANRESOURCE_COMPLETED" /** Complete clean resource by callback or unload event*/
 #define MSGID_START_LAUNCHURL               "START_LAUNCHURL" /** Start LaunchUrl on WebAppManager */
+#define MSGID_BACKGROUND_CPU_BUDGET         "BACKGROUND_CPU_BUDGET" /** Background app exceeds its CPU budget and is throttled */
+#define MSGID_CGROUP                        "CGROUP" /** Renderer is placed into a cgroup by app state */
+#define MSGID_CGROUP_WRITE_FAIL             "CGROUP_WRITE_FAIL" /** Fail to write a cgroup file */
+#define MSGID_DEEP_SUSPEND                  "DEEP_SUSPEND" /** Idle background renderer is frozen or thawed */
+#define MSGID_OOM_SCORE_ADJ                 "OOM_SCORE_ADJ" /** oom_score_adj of a renderer is updated */
+#define MSGID_IO_PRIORITY                   "IO_PRIORITY" /** I/O priority of a renderer or housekeeping is set */
+#define MSGID_DISK_WRITE_BUDGET             "DISK_WRITE_BUDGET" /** App writes more than the budget of its class */
+#define MSGID_CPU_AFFINITY                  "CPU_AFFINITY" /** Renderer is pinned to big or little cores */
+#define MSGID_LAUNCH_BOOST                  "LAUNCH_BOOST" /** Scheduling boost of a launch begins or ends */
+#define MSGID_PSI_MONITOR                   "PSI_MONITOR" /** PSI memory pressure trigger or level */
+#define MSGID_KEEPALIVE_TRIM                "KEEPALIVE_TRIM" /** Hidden keepAlive app is trimmed */
+#define MSGID_MEMORY_PRESSURE_EVENT         "MEMORY_PRESSURE_EVENT" /** webOSMemoryPressure is sent to an app */
+#define MSGID_PRELOAD_ADMISSION             "PRELOAD_ADMISSION" /** Preload is admitted, deferred, rejected or evicted */
+#define MSGID_LAUNCH_SCHEDULER              "LAUNCH_SCHEDULER" /** Launch work is queued or delayed by priority */
+#define MSGID_IDLE_TASK                     "IDLE_TASK" /** Deferred maintenance task ran in idle time */
+#define MSGID_LOW_POWER                     "LOW_POWER" /** Low-power mode is entered or left */
+#define MSGID_EXCLUSIVE_MODE                "EXCLUSIVE_MODE" /** Exclusive foreground mode is entered or left */
+#define MSGID_CLOSE_GRACE                   "CLOSE_GRACE" /** Close of app is deferred during the grace period */
 #define MSGID_CLOSE_APP_INTERNAL            "CLOSE_APP_INTERNAL" /** Close App */
 #define MSGID_WEBPAGE_LOAD                  "WEBPAGE_LOAD" /** Webpage load starts */
 #define MSGID_WEBPAGE_LOAD_FINISHED         "WEBPAGE_LOAD_FINISHED" /** WebPage load finished */
@@ -17,12 +17,58 @@
 #include "WebAppManagerUtils.h"
 
 #include <unistd.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <dirent.h>
+#include <algorithm>
 #include <fstream>
 #include <grp.h>
 
+// Not every libc/kernel header in the SDK knows about these yet
+#ifndef __NR_pidfd_send_signal
+#define __NR_pidfd_send_signal 424
+#endif
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+#ifndef __NR_process_madvise
+#define __NR_process_madvise 440
+#endif
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT 21
+#endif
+
+// From linux/ioprio.h, which glibc does not wrap
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_WHO_PROCESS 1
+
+// From linux/sched/types.h, util clamps need sched_setattr which glibc does not wrap
+#define SCHED_FLAG_KEEP_ALL 0x18
+#define SCHED_FLAG_UTIL_CLAMP_MIN 0x20
+
+struct SchedAttr {
+    uint32_t size;
+    uint32_t schedPolicy;
+    uint64_t schedFlags;
+    int32_t schedNice;
+    uint32_t schedPriority;
+    uint64_t schedRuntime;
+    uint64_t schedDeadline;
+    uint64_t schedPeriod;
+    uint32_t schedUtilMin;
+    uint32_t schedUtilMax;
+};
+
 int WebAppManagerUtils::updateAndGetCpuIdle(bool updateOnly)
 {
     static long oldCpuTime[4];
@@ -166,3 +212,309 @@ bool WebAppManagerUtils::setGroups() {
     return true;
 }
 
+
+int WebAppManagerUtils::openPidFd(int pid)
+{
+    return syscall(__NR_pidfd_open, pid, 0);
+}
+
+int WebAppManagerUtils::sendPidFdSignal(int pidfd, int sig)
+{
+    return syscall(__NR_pidfd_send_signal, pidfd, sig, NULL, 0);
+}
+
+bool WebAppManagerUtils::pageOutProcessMemory(int pid)
+{
+    int pidfd = openPidFd(pid);
+    if (pidfd == -1)
+        return false;
+
+    std::vector<struct iovec> ranges;
+    std::string mapsPath = "/proc/" + std::to_string(pid) + "/maps";
+    std::ifstream ifs(mapsPath.c_str());
+    std::string line;
+    while (getline(ifs, line)) {
+        unsigned long start, end;
+        char perms[5];
+        if (sscanf(line.c_str(), "%lx-%lx %4s", &start, &end, perms) != 3)
+            continue;
+
+        // Only private writable mappings (heaps, JS heap, stacks) are worth reclaiming
+        if (perms[1] != 'w' || perms[3] != 'p')
+            continue;
+
+        struct iovec range;
+        range.iov_base = reinterpret_cast<void*>(start);
+        range.iov_len = end - start;
+        ranges.push_back(range);
+    }
+    ifs.close();
+
+    bool advised = false;
+    for (size_t i = 0; i < ranges.size(); i += IOV_MAX) {
+        size_t count = std::min(ranges.size() - i, static_cast<size_t>(IOV_MAX));
+        if (syscall(__NR_process_madvise, pidfd, &ranges[i], count, MADV_PAGEOUT, 0) != -1) {
+            advised = true;
+            continue;
+        }
+
+        // Not supported by the kernel or not permitted; later batches would fail the same way
+        if (errno == ENOSYS || errno == EPERM || errno == EBADF || errno == ESRCH)
+            break;
+    }
+
+    close(pidfd);
+    return advised;
+}
+
+unsigned int WebAppManagerUtils::getProcessPss(int pid, const std::string& procRoot)
+{
+    // Returns PSS in KB, 0 when it can not be read
+    std::string rollupPath = procRoot + "/" + std::to_string(pid) + "/smaps_rollup";
+    std::ifstream ifs(rollupPath.c_str());
+    std::string line;
+    while (getline(ifs, line)) {
+        if (!line.compare(0, 4, "Pss:"))
+            return strtoul(line.c_str() + 4, NULL, 10);
+    }
+
+    return 0;
+}
+
+long WebAppManagerUtils::getProcessCpuTime(int pid)
+{
+    // Returns user + system time in ms, -1 when it can not be read
+    std::string statPath = "/proc/" + std::to_string(pid) + "/stat";
+    std::ifstream ifs(statPath.c_str());
+    std::string stat;
+    if (!getline(ifs, stat))
+        return -1;
+
+    // comm may contain spaces, so count the fields from its closing ')'
+    size_t commEnd = stat.rfind(')');
+    if (commEnd == std::string::npos)
+        return -1;
+
+    unsigned long utime = 0, stime = 0;
+    if (sscanf(stat.c_str() + commEnd + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2)
+        return -1;
+
+    static long ticksPerSec = sysconf(_SC_CLK_TCK);
+    if (ticksPerSec <= 0)
+        return -1;
+
+    return static_cast<long>((utime + stime) * 1000 / ticksPerSec);
+}
+
+long WebAppManagerUtils::getProcessContextSwitches(int pid)
+{
+    // Returns the context switches of all threads, -1 when they can not be read
+    std::string taskPath = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = opendir(taskPath.c_str());
+    if (!dir)
+        return -1;
+
+    long switches = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        std::ifstream ifs((taskPath + "/" + entry->d_name + "/status").c_str());
+        std::string line;
+        while (getline(ifs, line)) {
+            if (!line.compare(0, 24, "voluntary_ctxt_switches:"))
+                switches += strtol(line.c_str() + 24, NULL, 10);
+            else if (!line.compare(0, 27, "nonvoluntary_ctxt_switches:"))
+                switches += strtol(line.c_str() + 27, NULL, 10);
+        }
+    }
+    closedir(dir);
+
+    return switches;
+}
+
+int WebAppManagerUtils::ioPriority(IoPriorityClass ioClass, int level)
+{
+    // The idle class has no levels
+    if (ioClass == IoPriorityClassIdle)
+        level = 0;
+    return (ioClass << IOPRIO_CLASS_SHIFT) | std::min(std::max(level, 0), 7);
+}
+
+int WebAppManagerUtils::getThreadIoPriority()
+{
+    return syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0);
+}
+
+bool WebAppManagerUtils::setThreadIoPriority(int priority)
+{
+    return syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, priority) == 0;
+}
+
+bool WebAppManagerUtils::setProcessIoPriority(int pid, int priority)
+{
+    // I/O priority belongs to each thread unless they share an io_context
+    std::string taskPath = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = opendir(taskPath.c_str());
+    if (!dir)
+        return false;
+
+    bool result = true;
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        // Threads may exit while we walk the list
+        int tid = atoi(entry->d_name);
+        if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, tid, priority) == -1 && errno != ESRCH)
+            result = false;
+    }
+    closedir(dir);
+
+    return result;
+}
+
+bool WebAppManagerUtils::getCpuTimes(unsigned long long& idleTime, unsigned long long& totalTime)
+{
+    // Aggregate jiffies of all cpus, iowait counts as idle
+    std::ifstream ifs("/proc/stat");
+    std::string cpu;
+    unsigned long long times[8] = { 0 };
+    ifs >> cpu;
+    if (cpu != "cpu")
+        return false;
+
+    totalTime = 0;
+    for (int i = 0; i < 8 && ifs >> times[i]; i++)
+        totalTime += times[i];
+    idleTime = times[3] + times[4];
+    return totalTime > 0;
+}
+
+long long WebAppManagerUtils::getProcessWriteBytes(int pid)
+{
+    // Bytes the process caused to be sent to storage, -1 when unreadable
+    std::string ioPath = "/proc/" + std::to_string(pid) + "/io";
+    std::ifstream ifs(ioPath.c_str());
+    std::string line;
+    while (getline(ifs, line)) {
+        if (!line.compare(0, 12, "write_bytes:"))
+            return strtoll(line.c_str() + 12, NULL, 10);
+    }
+
+    return -1;
+}
+
+bool WebAppManagerUtils::setProcessCpuAffinity(int pid, const std::vector<int>& cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t i = 0; i < cpus.size(); i++)
+        CPU_SET(cpus[i], &set);
+
+    // Affinity belongs to each thread, new threads inherit it from their creator
+    std::string taskPath = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = opendir(taskPath.c_str());
+    if (!dir)
+        return false;
+
+    bool result = true;
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        if (sched_setaffinity(atoi(entry->d_name), sizeof(set), &set) == -1 && errno != ESRCH)
+            result = false;
+    }
+    closedir(dir);
+
+    return result;
+}
+
+std::vector<int> WebAppManagerUtils::getThreadIds(int pid)
+{
+    std::vector<int> tids;
+    std::string taskPath = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = opendir(taskPath.c_str());
+    if (!dir)
+        return tids;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] != '.')
+            tids.push_back(atoi(entry->d_name));
+    }
+    closedir(dir);
+
+    return tids;
+}
+
+bool WebAppManagerUtils::getThreadNice(int tid, int& nice)
+{
+    // getpriority returns -1 for nice -1 as well, so errno tells failures apart
+    errno = 0;
+    int value = getpriority(PRIO_PROCESS, tid);
+    if (value == -1 && errno)
+        return false;
+
+    nice = value;
+    return true;
+}
+
+bool WebAppManagerUtils::setThreadNice(int tid, int nice)
+{
+    return setpriority(PRIO_PROCESS, tid, std::min(std::max(nice, -20), 19)) == 0;
+}
+
+bool WebAppManagerUtils::setThreadUclampMin(int tid, unsigned int utilMin)
+{
+#ifdef SYS_sched_setattr
+    SchedAttr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.schedFlags = SCHED_FLAG_KEEP_ALL | SCHED_FLAG_UTIL_CLAMP_MIN;
+    attr.schedUtilMin = std::min(utilMin, 1024u);
+    return syscall(SYS_sched_setattr, tid, &attr, 0) == 0;
+#else
+    errno = ENOSYS;
+    return false;
+#endif
+}
+
+bool WebAppManagerUtils::setProcessUclampMin(int pid, unsigned int utilMin)
+{
+    std::vector<int> tids = getThreadIds(pid);
+    bool result = !tids.empty();
+    for (size_t i = 0; i < tids.size(); i++) {
+        if (!setThreadUclampMin(tids[i], utilMin) && errno != ESRCH)
+            result = false;
+    }
+
+    return result;
+}
+
+bool WebAppManagerUtils::setTimerSlack(unsigned long slackNs)
+{
+    // Slack of the calling thread, 0 goes back to the default of the thread
+    return prctl(PR_SET_TIMERSLACK, slackNs, 0, 0, 0) == 0;
+}
+
+bool WebAppManagerUtils::setProcessTimerSlack(int pid, unsigned long slackNs)
+{
+    // Another process can only be reached through procfs, needs CAP_SYS_NICE
+    std::vector<int> tids = getThreadIds(pid);
+    bool result = !tids.empty();
+    for (size_t i = 0; i < tids.size(); i++) {
+        std::string path = "/proc/" + std::to_string(pid) + "/task/" + std::to_string(tids[i]) + "/timerslack_ns";
+        std::ofstream ofs(path.c_str());
+        ofs << slackNs;
+        ofs.flush();
+        if (!ofs.good() && access(path.c_str(), F_OK) == 0)
+            result = false;
+    }
+
+    return result;
+}
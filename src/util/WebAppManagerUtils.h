@@ -22,8 +22,35 @@
 
 class WebAppManagerUtils {
 public:
+    enum IoPriorityClass {
+        IoPriorityClassNone = 0,
+        IoPriorityClassRealtime,
+        IoPriorityClassBestEffort,
+        IoPriorityClassIdle
+    };
+
     static int updateAndGetCpuIdle(bool updateOnly = false);
+    static bool getCpuTimes(unsigned long long& idleTime, unsigned long long& totalTime);
     static bool setGroups();
+    static int openPidFd(int pid);
+    static int sendPidFdSignal(int pidfd, int sig);
+    static bool pageOutProcessMemory(int pid);
+    static unsigned int getProcessPss(int pid, const std::string& procRoot = "/proc");
+    static long getProcessCpuTime(int pid);
+    static long getProcessContextSwitches(int pid);
+    static long long getProcessWriteBytes(int pid);
+    static int ioPriority(IoPriorityClass ioClass, int level);
+    static int getThreadIoPriority();
+    static bool setThreadIoPriority(int priority);
+    static bool setProcessIoPriority(int pid, int priority);
+    static bool setProcessCpuAffinity(int pid, const std::vector<int>& cpus);
+    static std::vector<int> getThreadIds(int pid);
+    static bool getThreadNice(int tid, int& nice);
+    static bool setThreadNice(int tid, int nice);
+    static bool setThreadUclampMin(int tid, unsigned int utilMin);
+    static bool setProcessUclampMin(int pid, unsigned int utilMin);
+    static bool setTimerSlack(unsigned long slackNs);
+    static bool setProcessTimerSlack(int pid, unsigned long slackNs);
 
 private:
     static long percentages(int cnt, int* out, long* now, long* old, long* diffs);
@@ -48,6 +48,20 @@ LSMethod WebAppManagerServiceLuna::s_privateMethods[] = {
     LS2_METHOD_ENTRY(getWebProcessSize),
     LS2_METHOD_ENTRY(closeByProcessId),
     LS2_METHOD_ENTRY(clearBrowsingData),
+    LS2_METHOD_ENTRY(getCrashRecoveryStats),
+    LS2_METHOD_ENTRY(getReclaimCandidates),
+    LS2_METHOD_ENTRY(getSuspendDelayStats),
+    LS2_METHOD_ENTRY(getBackgroundCpuStats),
+    LS2_METHOD_ENTRY(getDeepSuspendStats),
+    LS2_METHOD_ENTRY(getDiskWriteStats),
+    LS2_METHOD_ENTRY(getLaunchBoostStats),
+    LS2_METHOD_ENTRY(getKeepAliveTrimStats),
+    LS2_METHOD_ENTRY(getLaunchSchedulerStats),
+    LS2_METHOD_ENTRY(getIdleTaskStats),
+    LS2_METHOD_ENTRY(setPowerState),
+    LS2_METHOD_ENTRY(getLowPowerStats),
+    LS2_METHOD_ENTRY(setExclusiveForeground),
+    LS2_METHOD_ENTRY(getExclusiveModeStats),
     LS2_SUBSCRIPTION_ENTRY(listRunningApps),
     LS2_SUBSCRIPTION_ENTRY(webProcessCreated),
     { 0, 0 }
@@ -233,6 +247,119 @@ QJsonObject WebAppManagerServiceLuna::getWebProcessSize(QJsonObject request)
     return reply;
 }
 
+QJsonObject WebAppManagerServiceLuna::getCrashRecoveryStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetCrashRecoveryStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getReclaimCandidates(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetReclaimCandidates();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getSuspendDelayStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetSuspendDelayStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getBackgroundCpuStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetBackgroundCpuStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getDeepSuspendStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetDeepSuspendStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getDiskWriteStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetDiskWriteStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getLaunchBoostStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetLaunchBoostStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getKeepAliveTrimStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetKeepAliveTrimStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getLaunchSchedulerStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetLaunchSchedulerStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getIdleTaskStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetIdleTaskStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::setPowerState(QJsonObject request)
+{
+    QJsonObject reply;
+    bool returnValue = WebAppManagerService::onSetPowerState(request["state"].toString());
+    if (!returnValue) {
+        reply["errorCode"] = ERR_CODE_POWER_STATE_INVALID_VALUE;
+        reply["errorText"] = QString::fromStdString(err_invalidValue).append(": %1").arg(request["state"].toString());
+    }
+
+    reply["returnValue"] = returnValue;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getLowPowerStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetLowPowerStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::setExclusiveForeground(QJsonObject request)
+{
+    QJsonObject reply;
+    QString appId = request["appId"].toString();
+    if (appId.isEmpty()) {
+        reply["errorCode"] = ERR_CODE_EXCLUSIVE_MISS_APP_ID;
+        reply["errorText"] = QString::fromStdString(err_missAppId);
+        reply["returnValue"] = false;
+        return reply;
+    }
+
+    WebAppManagerService::onSetExclusiveForeground(appId, request["exclusive"].toBool(true));
+    reply["returnValue"] = true;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::getExclusiveModeStats(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::onGetExclusiveModeStats();
+    reply["returnValue"] = true;
+    return reply;
+}
+
 QJsonObject WebAppManagerServiceLuna::listRunningApps(QJsonObject request, bool subscribed)
 {
     bool includeSysApps = request["includeSysApps"].toBool();
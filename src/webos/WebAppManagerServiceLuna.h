@@ -43,6 +43,20 @@ public:
     QJsonObject getWebProcessSize(QJsonObject request) override;
     QJsonObject clearBrowsingData(QJsonObject request) override;
     QJsonObject webProcessCreated(QJsonObject request, bool subscribed) override;
+    QJsonObject getCrashRecoveryStats(QJsonObject request) override;
+    QJsonObject getReclaimCandidates(QJsonObject request) override;
+    QJsonObject getSuspendDelayStats(QJsonObject request) override;
+    QJsonObject getBackgroundCpuStats(QJsonObject request) override;
+    QJsonObject getDeepSuspendStats(QJsonObject request) override;
+    QJsonObject getDiskWriteStats(QJsonObject request) override;
+    QJsonObject getLaunchBoostStats(QJsonObject request) override;
+    QJsonObject getKeepAliveTrimStats(QJsonObject request) override;
+    QJsonObject getLaunchSchedulerStats(QJsonObject request) override;
+    QJsonObject getIdleTaskStats(QJsonObject request) override;
+    QJsonObject setPowerState(QJsonObject request) override;
+    QJsonObject getLowPowerStats(QJsonObject request) override;
+    QJsonObject setExclusiveForeground(QJsonObject request) override;
+    QJsonObject getExclusiveModeStats(QJsonObject request) override;
 
     // PlamServiceBase
     void didConnect() override;
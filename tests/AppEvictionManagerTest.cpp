@@ -0,0 +1,173 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AppEvictionManagerTest.h"
+
+#include <glib.h>
+
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "AppEvictionManager.h"
+#include "TestPlatform.h"
+
+static QTemporaryDir* s_procDir = 0;
+
+// Synthetic smaps_rollup of a renderer under WAM_PROC_ROOT, PSS in MB
+static void setRendererPss(uint32_t pid, uint32_t pssSize)
+{
+    QByteArray rollup = "Rss: " + QByteArray::number(pssSize * 1024 * 2) + " kB\n"
+        + "Pss: " + QByteArray::number(pssSize * 1024) + " kB\n";
+    QVERIFY(TestPlatform::writeFile(QString("%1/%2/smaps_rollup").arg(s_procDir->path()).arg(pid), rollup));
+}
+
+static void setIdleMinutes(AppEvictionManager& manager, const FakeWebApp& app, int minutes)
+{
+    manager.m_evictionInfoMap[app.appId()].lastActivationTime = g_get_monotonic_time() - minutes * 60 * G_USEC_PER_SEC;
+}
+
+void AppEvictionManagerTest::init()
+{
+    s_procDir = new QTemporaryDir();
+    QVERIFY(s_procDir->isValid());
+    qputenv("WAM_PROC_ROOT", QFile::encodeName(s_procDir->path()));
+    TestPlatform::reloadConfig();
+}
+
+void AppEvictionManagerTest::cleanup()
+{
+    qunsetenv("WAM_PROC_ROOT");
+    qunsetenv("ENABLE_APP_EVICTION");
+    TestPlatform::reloadConfig();
+
+    delete s_procDir;
+    s_procDir = 0;
+}
+
+void AppEvictionManagerTest::rankedCandidates()
+{
+    AppEvictionManager manager;
+
+    // One point per idle minute and per 16MB of PSS
+    FakeWebApp recent(QStringLiteral("com.webos.app.recent"), 1001);
+    setRendererPss(1001, 32);
+    setIdleMinutes(manager, recent, 1);
+
+    FakeWebApp idle(QStringLiteral("com.webos.app.idle"), 1002);
+    setRendererPss(1002, 16);
+    setIdleMinutes(manager, idle, 30);
+
+    FakeWebApp large(QStringLiteral("com.webos.app.large"), 1003);
+    setRendererPss(1003, 320);
+    setIdleMinutes(manager, large, 5);
+
+    FakeWebApp keepAlive(QStringLiteral("com.webos.app.keepalive"), 1004);
+    keepAlive.setKeepAlive(true);
+    setRendererPss(1004, 64);
+    setIdleMinutes(manager, keepAlive, 60);
+
+    // Never activated, idle since its launch
+    FakeWebApp preload(QStringLiteral("com.webos.app.preload"), 1005);
+    preload.setPreloadState(QStringLiteral("{\"preload\":\"full\"}"));
+    setRendererPss(1005, 48);
+    manager.m_evictionInfoMap[preload.appId()].launchTime = g_get_monotonic_time() - 2 * 60 * G_USEC_PER_SEC;
+
+    // A shared renderer is split between its apps
+    FakeWebApp sharedOld(QStringLiteral("com.webos.app.shared.old"), 1006);
+    FakeWebApp sharedNew(QStringLiteral("com.webos.app.shared.new"), 1006);
+    setRendererPss(1006, 128);
+    setIdleMinutes(manager, sharedOld, 20);
+    setIdleMinutes(manager, sharedNew, 10);
+
+    // Visible and system UI apps are never candidates
+    FakeWebApp foreground(QStringLiteral("com.webos.app.foreground"), 1007);
+    foreground.setActivated(true);
+    setRendererPss(1007, 512);
+    FakeWebApp systemUi(QStringLiteral("com.webos.app.systemui"), 1008, QStringLiteral("system_ui"));
+    setRendererPss(1008, 512);
+    setIdleMinutes(manager, systemUi, 60);
+
+    std::vector<AppEvictionManager::Candidate> candidates = manager.rankedCandidates();
+
+    const FakeWebApp* expectedApps[] = { &preload, &idle, &large, &sharedOld, &sharedNew, &recent, &keepAlive };
+    const uint32_t expectedPss[] = { 48, 16, 320, 64, 64, 32, 64 };
+    const int expectedScores[] = { 2 + 3 + 1000, 30 + 1, 5 + 20, 20 + 4, 10 + 4, 1 + 2, 60 + 4 - 500 };
+    QCOMPARE(candidates.size(), sizeof(expectedApps) / sizeof(expectedApps[0]));
+    for (size_t i = 0; i < candidates.size(); i++) {
+        QCOMPARE(candidates.at(i).app->appId(), expectedApps[i]->appId());
+        QCOMPARE(candidates.at(i).pssSize, expectedPss[i] * 1024);
+        QCOMPARE(candidates.at(i).score, expectedScores[i]);
+    }
+}
+
+void AppEvictionManagerTest::tierEscalation()
+{
+    qputenv("ENABLE_APP_EVICTION", "1");
+    TestPlatform::reloadConfig();
+
+    AppEvictionManager manager;
+    FakeWebApp first(QStringLiteral("com.webos.app.first"), 2001);
+    FakeWebApp second(QStringLiteral("com.webos.app.second"), 2002);
+    FakeWebApp third(QStringLiteral("com.webos.app.third"), 2003);
+    FakeWebApp foreground(QStringLiteral("com.webos.app.foreground"), 2004);
+    foreground.setActivated(true);
+    setRendererPss(2001, 64);
+    setRendererPss(2002, 64);
+    setRendererPss(2003, 64);
+    setIdleMinutes(manager, first, 30);
+    setIdleMinutes(manager, second, 20);
+    setIdleMinutes(manager, third, 10);
+
+    // LOW trims and suspends every background app but takes nothing away
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_LOW);
+    const FakeWebApp* background[] = { &first, &second, &third };
+    for (size_t i = 0; i < 3; i++) {
+        QCOMPARE(background[i]->fakePage()->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_LOW);
+        QVERIFY(background[i]->fakePage()->isSuspended());
+        QVERIFY(!background[i]->isDiscarded());
+        QCOMPARE(manager.m_evictionInfoMap.value(background[i]->appId()).tier, AppEvictionManager::TierSuspend);
+    }
+    QCOMPARE(foreground.fakePage()->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_NONE);
+    QVERIFY(!foreground.fakePage()->isSuspended());
+
+    // Each transition to CRITICAL discards the next candidate, repeats do nothing
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    QVERIFY(first.isDiscarded());
+    QVERIFY(!second.isDiscarded());
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    QVERIFY(!second.isDiscarded());
+
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_LOW);
+    QVERIFY(!second.isDiscarded());
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    QVERIFY(second.isDiscarded());
+    QVERIFY(!third.isDiscarded());
+
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_NONE);
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    QVERIFY(third.isDiscarded());
+    QVERIFY(!foreground.isDiscarded());
+
+    // With everything discarded the next step closes the first candidate
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_LOW);
+    manager.memoryPressureChanged(webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    QCOMPARE(manager.m_evictionInfoMap.value(first.appId()).tier, AppEvictionManager::TierClose);
+    QCOMPARE(manager.m_evictionInfoMap.value(second.appId()).tier, AppEvictionManager::TierDiscard);
+
+    // Activation takes the app out of the tiers
+    manager.appActivated(first.appId());
+    QCOMPARE(manager.m_evictionInfoMap.value(first.appId()).tier, AppEvictionManager::TierNone);
+}
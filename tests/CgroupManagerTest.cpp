@@ -0,0 +1,125 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CgroupManagerTest.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "CgroupManager.h"
+#include "TestPlatform.h"
+
+// Returns the pids written to a group since the last call
+static QByteArray takeProcs(const QString& root, const char* group)
+{
+    QString path = root + QLatin1Char('/') + QLatin1String(group) + QLatin1String("/cgroup.procs");
+    QByteArray procs = TestPlatform::readFile(path);
+    QFile::remove(path);
+    return procs;
+}
+
+void CgroupManagerTest::cleanup()
+{
+    qunsetenv("WAM_CGROUP_ROOT");
+    qunsetenv("WAM_CGROUP_MEMORY_HIGH_IN_MB");
+    TestPlatform::reloadConfig();
+}
+
+void CgroupManagerTest::placement()
+{
+    // A cgroup v2 mount has cgroup.controllers in every group
+    QTemporaryDir cgroupfs;
+    QVERIFY(cgroupfs.isValid());
+    QVERIFY(TestPlatform::writeFile(cgroupfs.path() + QLatin1String("/cgroup.controllers"), "cpu memory"));
+    QString root = cgroupfs.path() + QLatin1String("/wam");
+    qputenv("WAM_CGROUP_ROOT", QFile::encodeName(root));
+    qputenv("WAM_CGROUP_MEMORY_HIGH_IN_MB", "background:300,preload:150");
+    TestPlatform::reloadConfig();
+
+    CgroupManager cgroup;
+    cgroup.init();
+    QVERIFY(cgroup.isEnabled());
+
+    QCOMPARE(TestPlatform::readFile(cgroupfs.path() + QLatin1String("/cgroup.subtree_control")), QByteArray("+cpu +memory"));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/cgroup.subtree_control")), QByteArray("+cpu +memory"));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/preload/cpu.weight")), QByteArray("20"));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/background/cpu.weight")), QByteArray("100"));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/foreground/cpu.weight")), QByteArray("1000"));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/preload/memory.high")), QByteArray::number(150 * 1024 * 1024));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/background/memory.high")), QByteArray::number(300 * 1024 * 1024));
+    QCOMPARE(TestPlatform::readFile(root + QLatin1String("/foreground/memory.high")), QByteArray("max"));
+
+    FakeWebApp app(QStringLiteral("com.webos.app.cgroup"), 3001);
+    FakeWebApp preload(QStringLiteral("com.webos.app.cgroup.preload"), 3002);
+    preload.setPreloadState(QStringLiteral("{\"preload\":\"partial\"}"));
+
+    cgroup.webProcessCreated(3001);
+    cgroup.webProcessCreated(3002);
+    QCOMPARE(takeProcs(root, "background"), QByteArray("3001"));
+    QCOMPARE(takeProcs(root, "preload"), QByteArray("3002"));
+
+    app.setActivated(true);
+    cgroup.appActivated(&app);
+    QCOMPARE(takeProcs(root, "foreground"), QByteArray("3001"));
+
+    // A renderer is only moved when its group changes
+    cgroup.appActivated(&app);
+    QVERIFY(takeProcs(root, "foreground").isEmpty());
+
+    // A shared renderer follows its most important app
+    FakeWebApp peer(QStringLiteral("com.webos.app.cgroup.peer"), 3001);
+    app.setActivated(false);
+    cgroup.appDeactivated(&app);
+    QCOMPARE(takeProcs(root, "background"), QByteArray("3001"));
+    peer.setActivated(true);
+    cgroup.appActivated(&peer);
+    QCOMPARE(takeProcs(root, "foreground"), QByteArray("3001"));
+    cgroup.appClosed(peer.appId(), 3001);
+    QCOMPARE(takeProcs(root, "background"), QByteArray("3001"));
+
+    // The kernel drops exited pids, a reused pid is placed again
+    cgroup.webProcessExited(3002);
+    cgroup.webProcessCreated(3002);
+    QCOMPARE(takeProcs(root, "preload"), QByteArray("3002"));
+}
+
+void CgroupManagerTest::noCgroupV2()
+{
+    // cgroup v1 and no cgroupfs at all look the same, no cgroup.controllers
+    QTemporaryDir cgroupfs;
+    QVERIFY(cgroupfs.isValid());
+    QString root = cgroupfs.path() + QLatin1String("/wam");
+    qputenv("WAM_CGROUP_ROOT", QFile::encodeName(root));
+    TestPlatform::reloadConfig();
+
+    CgroupManager cgroup;
+    cgroup.init();
+    QVERIFY(!cgroup.isEnabled());
+
+    FakeWebApp app(QStringLiteral("com.webos.app.cgroup"), 3001);
+    app.setActivated(true);
+    cgroup.webProcessCreated(3001);
+    cgroup.appActivated(&app);
+    QVERIFY(QDir(cgroupfs.path()).entryList(QDir::NoDotAndDotDot | QDir::AllEntries).isEmpty());
+
+    // Without WAM_CGROUP_ROOT nothing is placed either
+    qunsetenv("WAM_CGROUP_ROOT");
+    TestPlatform::reloadConfig();
+    CgroupManager unconfigured;
+    unconfigured.init();
+    QVERIFY(!unconfigured.isEnabled());
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "IoPriorityTest.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <QtTest/QtTest>
+
+#include "TestPlatform.h"
+#include "WebAppManager.h"
+#include "WebAppManagerUtils.h"
+
+#include <glib.h>
+
+// A launch writes its disk cache and local storage in small synced pieces
+static const int kLaunchWrites = 64;
+static const size_t kLaunchWriteSize = 16 * 1024;
+
+// The background app keeps the device queue full with large synced writes
+static const size_t kBackgroundWriteSize = 4 * 1024 * 1024;
+static char s_writeBuffer[kBackgroundWriteSize];
+
+static pid_t forkBackgroundWriter(const QString& dir)
+{
+    QByteArray path = QFile::encodeName(dir + QLatin1String("/background.data"));
+    pid_t pid = fork();
+    if (pid != 0)
+        return pid;
+
+    // Only async-signal-safe calls from here on, runs until it is killed
+    int fd = open(path.constData(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1)
+        _exit(1);
+    while (true) {
+        for (int i = 0; i < 16; i++) {
+            if (write(fd, s_writeBuffer, kBackgroundWriteSize) != static_cast<ssize_t>(kBackgroundWriteSize))
+                _exit(1);
+        }
+        fdatasync(fd);
+        lseek(fd, 0, SEEK_SET);
+    }
+}
+
+// Returns the wall time of the launch I/O in ms, or -1 on failure
+static double launchIo(const QString& dir)
+{
+    QByteArray path = QFile::encodeName(dir + QLatin1String("/launch.data"));
+    char data[kLaunchWriteSize];
+    memset(data, 1, sizeof(data));
+
+    gint64 start = g_get_monotonic_time();
+    int fd = open(path.constData(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1)
+        return -1;
+    for (int i = 0; i < kLaunchWrites; i++) {
+        if (write(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || fdatasync(fd) == -1) {
+            close(fd);
+            return -1;
+        }
+    }
+    close(fd);
+    unlink(path.constData());
+    return (g_get_monotonic_time() - start) / 1000.0;
+}
+
+void IoPriorityTest::cleanup()
+{
+    qunsetenv("ENABLE_IO_PRIORITY");
+    TestPlatform::reloadConfig();
+}
+
+void IoPriorityTest::launchUnderBackgroundWrites()
+{
+    // tmpfs and the page cache never reach a device queue, so this only
+    // means something on the storage apps are loaded from
+    QString dir = QFile::decodeName(qgetenv("WAM_IO_BENCHMARK_DIR"));
+    if (dir.isEmpty())
+        QSKIP("Set WAM_IO_BENCHMARK_DIR to a directory on the device under test");
+
+    double idleDevice = launchIo(dir);
+    QVERIFY(idleDevice >= 0);
+
+    pid_t pid = forkBackgroundWriter(dir);
+    QVERIFY(pid > 0);
+    FakeWebApp app(QStringLiteral("com.webos.app.iowriter"), pid);
+
+    // Without I/O priorities the writer competes at the default class
+    QTest::qWait(2000);
+    double defaultClass = launchIo(dir);
+
+    qputenv("ENABLE_IO_PRIORITY", "1");
+    TestPlatform::reloadConfig();
+    WebAppManager::instance()->getWebProcessManager()->updateWebProcessPriority(pid);
+    int priority = syscall(SYS_ioprio_get, 1 /* IOPRIO_WHO_PROCESS */, pid);
+
+    QTest::qWait(2000);
+    double idleClass = launchIo(dir);
+
+    kill(pid, SIGKILL);
+    TestPlatform::waitRenderer(pid);
+    QFile::remove(dir + QLatin1String("/background.data"));
+
+    QVERIFY(defaultClass >= 0 && idleClass >= 0);
+    QCOMPARE(priority, WebAppManagerUtils::ioPriority(WebAppManagerUtils::IoPriorityClassIdle, 0));
+
+    // Only schedulers with I/O classes, BFQ and CFQ, tell them apart, so
+    // the numbers are reported rather than compared
+    qDebug("Launch I/O ms idle device %.1f, writer at default class %.1f, writer at idle class %.1f",
+        idleDevice, defaultClass, idleClass);
+    QTest::setBenchmarkResult(idleClass, QTest::WalltimeMilliseconds);
+}
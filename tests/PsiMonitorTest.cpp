@@ -0,0 +1,119 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PsiMonitorTest.h"
+
+#include <unistd.h>
+
+#include <QtTest/QtTest>
+
+#include "PsiMonitor.h"
+#include "TestPlatform.h"
+
+#include <glib.h>
+
+// Stands in for the kernel reporting a stall over a trigger threshold
+static bool fireTrigger(int fd)
+{
+    char event = 'p';
+    return write(fd, &event, 1) == 1;
+}
+
+void PsiMonitorTest::cleanup()
+{
+    qunsetenv("WAM_PSI_RELEASE_IN_MS");
+    TestPlatform::reloadConfig();
+}
+
+void PsiMonitorTest::riseAndRelease()
+{
+    qputenv("WAM_PSI_RELEASE_IN_MS", "300");
+    TestPlatform::reloadConfig();
+
+    // The foreground app is told every level change
+    FakeWebApp app(QStringLiteral("com.webos.app.psi"), 5001);
+    app.setActivated(true);
+    FakeWebPage* page = app.fakePage();
+
+    int lowPipe[2];
+    int criticalPipe[2];
+    QVERIFY(pipe(lowPipe) == 0);
+    QVERIFY(pipe(criticalPipe) == 0);
+
+    {
+        PsiMonitor monitor;
+        QVERIFY(monitor.watchTrigger(lowPipe[0], webos::WebViewBase::MEMORY_PRESSURE_LOW));
+        QVERIFY(monitor.watchTrigger(criticalPipe[0], webos::WebViewBase::MEMORY_PRESSURE_CRITICAL));
+        QVERIFY(monitor.isRunning());
+
+        // Rising follows the first trigger
+        QVERIFY(fireTrigger(lowPipe[1]));
+        QTRY_COMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_LOW);
+        QVERIFY(fireTrigger(criticalPipe[1]));
+        QTRY_COMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+
+        // A lower trigger never lowers the level
+        QVERIFY(fireTrigger(lowPipe[1]));
+        QTest::qWait(100);
+        QCOMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+
+        // While low stalls keep coming the level only falls back to low,
+        // over more than one release check
+        gint64 end = g_get_monotonic_time() + 2500 * 1000;
+        while (g_get_monotonic_time() < end) {
+            QVERIFY(fireTrigger(lowPipe[1]));
+            QTest::qWait(100);
+        }
+        QCOMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_LOW);
+
+        // Quiet for the release time, the pressure is over
+        QTRY_COMPARE_WITH_TIMEOUT(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_NONE, 3000);
+        QVERIFY(monitor.isRunning());
+    }
+
+    close(lowPipe[1]);
+    close(criticalPipe[1]);
+}
+
+void PsiMonitorTest::triggerFailure()
+{
+    FakeWebApp app(QStringLiteral("com.webos.app.psi"), 5001);
+    app.setActivated(true);
+    FakeWebPage* page = app.fakePage();
+
+    int lowPipe[2];
+    int criticalPipe[2];
+    QVERIFY(pipe(lowPipe) == 0);
+    QVERIFY(pipe(criticalPipe) == 0);
+
+    PsiMonitor monitor;
+    QVERIFY(monitor.watchTrigger(lowPipe[0], webos::WebViewBase::MEMORY_PRESSURE_LOW));
+    QVERIFY(monitor.watchTrigger(criticalPipe[0], webos::WebViewBase::MEMORY_PRESSURE_CRITICAL));
+    QVERIFY(fireTrigger(criticalPipe[1]));
+    QTRY_COMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+
+    // Losing one trigger keeps the monitor running on the other
+    close(criticalPipe[1]);
+    QTest::qWait(100);
+    QVERIFY(monitor.isRunning());
+    QCOMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+
+    // Without any trigger left memorymanager is the only source again, so
+    // the level PSI raised must not stay behind
+    close(lowPipe[1]);
+    QTRY_VERIFY(!monitor.isRunning());
+    QCOMPARE(page->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_NONE);
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "AppEvictionManagerTest.h"
+#include "CgroupManagerTest.h"
+#include "IoPriorityTest.h"
+#include "PsiMonitorTest.h"
+#include "TestPlatform.h"
+#include "WebProcessManagerTest.h"
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dataDir;
+    if (!dataDir.isValid())
+        return 1;
+    TestPlatform::init(dataDir.path());
+
+    int status = 0;
+
+    AppEvictionManagerTest appEvictionManagerTest;
+    status |= QTest::qExec(&appEvictionManagerTest, argc, argv);
+
+    CgroupManagerTest cgroupManagerTest;
+    status |= QTest::qExec(&cgroupManagerTest, argc, argv);
+
+    IoPriorityTest ioPriorityTest;
+    status |= QTest::qExec(&ioPriorityTest, argc, argv);
+
+    PsiMonitorTest psiMonitorTest;
+    status |= QTest::qExec(&psiMonitorTest, argc, argv);
+
+    WebProcessManagerTest webProcessManagerTest;
+    status |= QTest::qExec(&webProcessManagerTest, argc, argv);
+
+    return status;
+}
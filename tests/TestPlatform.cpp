@@ -0,0 +1,205 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TestPlatform.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "ApplicationDescription.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+
+FakeWebPage::FakeWebPage(uint32_t pid)
+    : m_pid(pid)
+    , m_shown(false)
+    , m_suspended(false)
+    , m_discarded(false)
+    , m_exitedPid(0)
+    , m_lastMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE)
+{
+}
+
+FakeWebApp::FakeWebApp(const QString& appId, uint32_t pid, const QString& windowType)
+    : m_activated(false)
+{
+    QJsonObject desc;
+    desc["id"] = appId;
+    desc["defaultWindowType"] = windowType;
+    setAppDescription(ApplicationDescription::fromJsonString(QJsonDocument(desc).toJson().constData()));
+    setHiddenWindow(true);
+
+    FakeWebPage* page = new FakeWebPage(pid);
+    page->setAppId(appId);
+    attach(page);
+    WebAppManager::instance()->insertAppIntoList(this);
+}
+
+FakeWebApp::~FakeWebApp()
+{
+    WebAppManager::instance()->deleteAppIntoList(this);
+}
+
+void FakeWebApp::setActivated(bool activated)
+{
+    m_activated = activated;
+    setHiddenWindow(!activated);
+    fakePage()->setShown(fakePage()->hasBeenShown() || activated);
+}
+
+WebAppManagerConfig* TestPlatformModuleFactory::createWebAppManagerConfig()
+{
+    return new WebAppManagerConfig();
+}
+
+void TestPlatform::init(const QString& dataPath)
+{
+    // Nothing may be read from or written to the device paths
+    QDir().mkpath(dataPath + QLatin1String("/plugins"));
+    qputenv("WEBAPPFACTORY_PLUGIN_PATH", QFile::encodeName(dataPath + QLatin1String("/plugins")));
+    qputenv("WEBPROCESS_CONFIGURATION_PATH", QFile::encodeName(dataPath + QLatin1String("/wam.json")));
+    qputenv("WAM_QUARANTINE_LIST_PATH", QFile::encodeName(dataPath + QLatin1String("/quarantine.json")));
+
+    static TestPlatformModuleFactory factory;
+    WebAppManager::instance()->setPlatformModules(&factory);
+}
+
+void TestPlatform::reloadConfig()
+{
+    *WebAppManager::instance()->config() = WebAppManagerConfig();
+}
+
+bool TestPlatform::writeFile(const QString& path, const QByteArray& data)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+QByteArray TestPlatform::readFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll().trimmed();
+}
+
+static volatile sig_atomic_t s_terminated = 0;
+
+static void rendererTerminated(int)
+{
+    s_terminated = 1;
+}
+
+static void* touchMemory(size_t size)
+{
+    if (!size)
+        return 0;
+
+    void* memory = mmap(NULL, size * 1024, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        _exit(1);
+    memset(memory, 1, size * 1024);
+    return memory;
+}
+
+static void runRenderer(int pipeFd, int readyFd, size_t pressureMemSize, size_t termMemSize, size_t keptMemSize)
+{
+    // Only async-signal-safe calls from here on, the parent may hold any lock
+    signal(SIGTERM, rendererTerminated);
+    void* pressureMemory = touchMemory(pressureMemSize);
+    void* termMemory = touchMemory(termMemSize);
+    touchMemory(keptMemSize);
+
+    char ready = 'r';
+    if (write(readyFd, &ready, 1) != 1)
+        _exit(1);
+    close(readyFd);
+
+    while (true) {
+        struct pollfd pfd = { pipeFd, POLLIN, 0 };
+        if (poll(&pfd, 1, 10) > 0) {
+            char command;
+            if (read(pipeFd, &command, 1) != 1)
+                _exit(0);
+            if (pressureMemory) {
+                munmap(pressureMemory, pressureMemSize * 1024);
+                pressureMemory = 0;
+            }
+        }
+
+        if (s_terminated && termMemory) {
+            munmap(termMemory, termMemSize * 1024);
+            termMemory = 0;
+        }
+    }
+}
+
+pid_t TestPlatform::forkRenderer(int& pipeFd, size_t pressureMemSize, size_t termMemSize, size_t keptMemSize)
+{
+    int commandPipe[2];
+    int readyPipe[2];
+    if (pipe(commandPipe) == -1)
+        return -1;
+    if (pipe(readyPipe) == -1) {
+        close(commandPipe[0]);
+        close(commandPipe[1]);
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(commandPipe[1]);
+        close(readyPipe[0]);
+        runRenderer(commandPipe[0], readyPipe[1], pressureMemSize, termMemSize, keptMemSize);
+    }
+
+    close(commandPipe[0]);
+    close(readyPipe[1]);
+    pipeFd = commandPipe[1];
+
+    // Measurements start once all of the memory is resident
+    char ready = 0;
+    struct pollfd pfd = { readyPipe[0], POLLIN, 0 };
+    if (pid == -1 || poll(&pfd, 1, 5000) != 1 || read(readyPipe[0], &ready, 1) != 1) {
+        if (pid != -1) {
+            kill(pid, SIGKILL);
+            waitRenderer(pid);
+        }
+        close(commandPipe[1]);
+        pid = -1;
+    }
+    close(readyPipe[0]);
+    return pid;
+}
+
+int TestPlatform::waitRenderer(pid_t pid)
+{
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid)
+        return -1;
+    return status;
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TESTPLATFORM_H
+#define TESTPLATFORM_H
+
+#include <sys/types.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include "PlatformModuleFactory.h"
+#include "WebAppBase.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+// Page without a web engine, hosted by a settable renderer pid
+class FakeWebPage : public WebPageBase {
+public:
+    FakeWebPage(uint32_t pid);
+
+    void setWebProcessPID(uint32_t pid) { m_pid = pid; }
+    void setShown(bool shown) { m_shown = shown; }
+
+    // What the code under test asked of the page
+    webos::WebViewBase::MemoryPressureLevel lastMemoryPressure() const { return m_lastMemoryPressure; }
+    bool isSuspended() const { return m_suspended; }
+    bool isDiscarded() const { return m_discarded; }
+    uint32_t exitedPid() const { return m_exitedPid; }
+
+    void init() override {}
+    void* getWebContents() override { return 0; }
+    void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level) override { m_lastMemoryPressure = level; }
+    QUrl url() const override { return defaultUrl(); }
+    void replaceBaseUrl(QUrl newUrl) override {}
+    void loadUrl(const std::string& url) override {}
+    int progress() const override { return 100; }
+    bool hasBeenShown() const override { return m_shown; }
+    void setPageProperties() override {}
+    void setPreferredLanguages(const QString& language) override {}
+    void setDefaultFont(const QString& font) override {}
+    void reloadDefaultPage() override {}
+    void reload() override {}
+    void setVisibilityState(WebPageVisibilityState visibilityState) override {}
+    void setFocus(bool focus) override {}
+    QString title() override { return QString(); }
+    bool canGoBack() override { return false; }
+    void closeVkb() override {}
+    void updatePageSettings() override {}
+    void handleDeviceInfoChanged(const QString& deviceInfo) override {}
+    void evaluateJavaScript(const QString& jsCode) override {}
+    void evaluateJavaScriptInAllFrames(const QString& jsCode, const char* method = "") override {}
+    void setForceActivateVtg(bool enabled) override {}
+    uint32_t getWebProcessProxyID() override { return 0; }
+    uint32_t getWebProcessPID() const override { return m_pid; }
+    void createPalmSystem(WebAppBase* app) override {}
+    void suspendWebPageAll() override { m_suspended = true; }
+    void resumeWebPageAll() override { m_suspended = false; }
+    void suspendWebPageMedia() override {}
+    void resumeWebPageMedia() override {}
+    void resumeWebPagePaintingAndJSExecution() override {}
+    void forwardEvent(void* event) override {}
+    void webProcessExited(uint32_t pid) override { m_exitedPid = pid; }
+    bool discardWebView() override { m_discarded = true; return true; }
+
+protected:
+    void suspendWebPagePaintingAndJSExecution() override {}
+    void loadDefaultUrl() override {}
+    void addUserScript(const QString& script) override {}
+    void addUserScriptUrl(const QUrl& url) override {}
+    void loadErrorPage(int errorCode) override {}
+    void recreateWebView() override {}
+
+private:
+    uint32_t m_pid;
+    bool m_shown;
+    bool m_suspended;
+    bool m_discarded;
+    uint32_t m_exitedPid;
+    webos::WebViewBase::MemoryPressureLevel m_lastMemoryPressure;
+};
+
+// App without a window, registered with WebAppManager for its lifetime.
+// It starts hidden in the background.
+class FakeWebApp : public WebAppBase {
+public:
+    FakeWebApp(const QString& appId, uint32_t pid, const QString& windowType = QStringLiteral("card"));
+    ~FakeWebApp() override;
+
+    FakeWebPage* fakePage() const { return static_cast<FakeWebPage*>(page()); }
+    void setActivated(bool activated);
+
+    void init(int width, int height) override {}
+    void suspendAppRendering() override {}
+    void resumeAppRendering() override {}
+    bool isFocused() const override { return m_activated; }
+    void resize(int width, int height) override {}
+    bool isActivated() const override { return m_activated; }
+    bool isMinimized() override { return !m_activated; }
+    bool isNormal() override { return m_activated; }
+    void onStageActivated() override {}
+    void onStageDeactivated() override {}
+    void configureWindow(QString& type) override {}
+    void setWindowProperty(const QString& name, const QVariant& value) override {}
+    void platformBack() override {}
+    void setCursor(const QString& cursorArg, int hotspot_x, int hotspot_y) override {}
+    void setInputRegion(const QJsonDocument& jsonDoc) override {}
+    void setKeyMask(const QJsonDocument& jsonDoc) override {}
+    void hide(bool forcedHide = false) override {}
+    void focus() override {}
+    void unfocus() override {}
+    void setOpacity(float opacity) override {}
+    void raise() override {}
+    void goBackground() override {}
+    void deleteSurfaceGroup() override {}
+    void doClose() override {}
+
+protected:
+    void doAttach() override {}
+    void webPageLoadFailedSlot(int errorCode) override {}
+
+private:
+    bool m_activated;
+};
+
+class TestWebProcessManager : public WebProcessManager {
+public:
+    TestWebProcessManager()
+        : m_containerApp(0)
+    {
+    }
+
+    // Stands in for the spare container, there is no ContainerAppManager
+    void setContainerApp(WebAppBase* app) { m_containerApp = app; }
+
+    QJsonObject getWebProcessProfiling() override { return QJsonObject(); }
+    uint32_t getWebProcessPID(const WebAppBase* app) const override { return app->page()->getWebProcessPID(); }
+    void deleteStorageData(const QString& identifier) override {}
+    uint32_t getInitialWebViewProxyID() const override { return 0; }
+    void clearBrowsingData(const int removeBrowsingDataMask) override {}
+    int maskForBrowsingDataType(const char* type) override { return 0; }
+
+protected:
+    WebAppBase* getContainerApp() override { return m_containerApp; }
+
+private:
+    WebAppBase* m_containerApp;
+};
+
+class TestPlatformModuleFactory : public PlatformModuleFactory {
+protected:
+    ServiceSender* createServiceSender() override { return 0; }
+    WebProcessManager* createWebProcessManager() override { return new TestWebProcessManager(); }
+    ContainerAppManager* createContainerAppManager() override { return 0; }
+    DeviceInfo* createDeviceInfo() override { return 0; }
+    WebAppManagerConfig* createWebAppManagerConfig() override;
+};
+
+class TestPlatform {
+public:
+    // Points WAM at a scratch directory and installs the test platform modules
+    static void init(const QString& dataPath);
+
+    // Re-reads WebAppManagerConfig after a test changed the environment
+    static void reloadConfig();
+
+    static bool writeFile(const QString& path, const QByteArray& data);
+    static QByteArray readFile(const QString& path);
+
+    // Forks a stand-in renderer holding the given KB of touched memory. It runs
+    // until the write end of its pipe, returned in pipeFd, is closed or it is
+    // killed. A byte written to the pipe frees pressureMemSize, SIGTERM frees
+    // termMemSize without exiting.
+    static pid_t forkRenderer(int& pipeFd, size_t pressureMemSize = 0, size_t termMemSize = 0, size_t keptMemSize = 0);
+    static int waitRenderer(pid_t pid);
+};
+
+#endif /* TESTPLATFORM_H */
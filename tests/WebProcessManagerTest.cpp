@@ -0,0 +1,257 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "WebProcessManagerTest.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "TestPlatform.h"
+#include "WebAppManager.h"
+
+// VmRSS of the stand-in renderer moves by a few pages on its own
+static const int64_t kMemSizeToleranceKB = 1024;
+
+static TestWebProcessManager* webProcessManager()
+{
+    return static_cast<TestWebProcessManager*>(WebAppManager::instance()->getWebProcessManager());
+}
+
+static QString cpuList(const std::vector<int>& cpus)
+{
+    QStringList list;
+    for (size_t i = 0; i < cpus.size(); i++)
+        list << QString::number(cpus[i]);
+    return list.join(',');
+}
+
+void WebProcessManagerTest::cleanup()
+{
+    qunsetenv("WAM_RECLAIM_STAGE_INTERVAL_IN_MS");
+    qunsetenv("WAM_RECLAIM_TERMINATE_TIMEOUT_IN_MS");
+    qunsetenv("ENABLE_OOM_SCORE_ADJ");
+    qunsetenv("WAM_OOM_SCORE_ADJ");
+    qunsetenv("WAM_PROC_ROOT");
+    qunsetenv("WAM_SYSFS_ROOT");
+    TestPlatform::reloadConfig();
+
+    webProcessManager()->m_webProcessInfoMap.remove(QStringLiteral("test"));
+    webProcessManager()->m_oomScoreAdjMap.clear();
+    webProcessManager()->setContainerApp(0);
+
+    // The topology is read again from the real sysfs when next needed
+    webProcessManager()->m_bigCpus.clear();
+    webProcessManager()->m_littleCpus.clear();
+    webProcessManager()->m_cpuTopologyRead = false;
+}
+
+void WebProcessManagerTest::oomScoreAdj_data()
+{
+    QTest::addColumn<QString>("state");
+    QTest::addColumn<QByteArray>("overrides");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("foreground") << "foreground" << QByteArray() << 0;
+    QTest::newRow("overlay") << "overlay" << QByteArray() << 100;
+    QTest::newRow("background") << "background" << QByteArray() << 500;
+    QTest::newRow("keepAlive") << "keepAlive" << QByteArray() << 700;
+    QTest::newRow("preload") << "preload" << QByteArray() << 800;
+    QTest::newRow("container") << "container" << QByteArray() << 900;
+    QTest::newRow("shared") << "shared" << QByteArray() << 0;
+    QTest::newRow("override") << "preload" << QByteArray("preload:950,background:-1") << 950;
+    QTest::newRow("out of range override") << "preload" << QByteArray("preload:2000") << 800;
+}
+
+void WebProcessManagerTest::oomScoreAdj()
+{
+    QFETCH(QString, state);
+    QFETCH(QByteArray, overrides);
+    QFETCH(int, expected);
+
+    // Writes land in <root>/<pid>/oom_score_adj as they would in /proc
+    QTemporaryDir procDir;
+    QVERIFY(procDir.isValid());
+    const uint32_t pid = 4001;
+    QString path = QString("%1/%2/oom_score_adj").arg(procDir.path()).arg(pid);
+    QVERIFY(QDir().mkpath(QFileInfo(path).absolutePath()));
+    qputenv("ENABLE_OOM_SCORE_ADJ", "1");
+    qputenv("WAM_OOM_SCORE_ADJ", overrides);
+    qputenv("WAM_PROC_ROOT", QFile::encodeName(procDir.path()));
+    TestPlatform::reloadConfig();
+
+    TestWebProcessManager* manager = webProcessManager();
+    FakeWebApp app(QStringLiteral("com.webos.app.oom"), pid, state == "overlay" ? QStringLiteral("overlay") : QStringLiteral("card"));
+    QScopedPointer<FakeWebApp> peer;
+    if (state == "foreground" || state == "overlay") {
+        app.setActivated(true);
+    } else if (state == "keepAlive") {
+        app.setKeepAlive(true);
+    } else if (state == "preload") {
+        app.setPreloadState(QStringLiteral("{\"preload\":\"partial\"}"));
+    } else if (state == "container") {
+        // The spare container is not among the running apps
+        WebAppManager::instance()->deleteAppIntoList(&app);
+        manager->setContainerApp(&app);
+    } else if (state == "shared") {
+        // A shared renderer is protected like its most important app
+        peer.reset(new FakeWebApp(QStringLiteral("com.webos.app.oom.peer"), pid));
+        app.setActivated(true);
+    }
+
+    manager->updateWebProcessPriority(pid);
+    QCOMPARE(TestPlatform::readFile(path), QByteArray::number(expected));
+
+    // Unchanged values are not written again
+    QVERIFY(QFile::remove(path));
+    manager->updateWebProcessPriority(pid);
+    QVERIFY(!QFile::exists(path));
+
+    // A renderer without apps is left alone
+    QString otherPath = QString("%1/%2/oom_score_adj").arg(procDir.path()).arg(pid + 1);
+    QVERIFY(QDir().mkpath(QFileInfo(otherPath).absolutePath()));
+    manager->updateWebProcessPriority(pid + 1);
+    QVERIFY(!QFile::exists(otherPath));
+}
+
+void WebProcessManagerTest::cpuTopology_data()
+{
+    QTest::addColumn<QString>("capacities");
+    QTest::addColumn<QString>("bigCpus");
+    QTest::addColumn<QString>("littleCpus");
+
+    QTest::newRow("big.LITTLE") << "512,512,512,512,1024,1024,1024,1024" << "4,5,6,7" << "0,1,2,3";
+    QTest::newRow("three clusters") << "1024,768,768,512" << "0" << "1,2,3";
+    QTest::newRow("symmetric") << "1024,1024,1024,1024" << "" << "";
+    QTest::newRow("no cpu_capacity") << "" << "" << "";
+}
+
+void WebProcessManagerTest::cpuTopology()
+{
+    QFETCH(QString, capacities);
+    QFETCH(QString, bigCpus);
+    QFETCH(QString, littleCpus);
+
+    // Laid out like /sys/devices/system/cpu, with the entries that are not cores
+    QTemporaryDir sysfsDir;
+    QVERIFY(sysfsDir.isValid());
+    QString cpuDir = sysfsDir.path() + QLatin1String("/devices/system/cpu");
+    QStringList capacityList = capacities.split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < capacityList.size(); i++)
+        QVERIFY(TestPlatform::writeFile(QString("%1/cpu%2/cpu_capacity").arg(cpuDir).arg(i), capacityList.at(i).toLatin1()));
+    QVERIFY(QDir().mkpath(QString("%1/cpu%2/cpufreq").arg(cpuDir).arg(capacityList.size())));
+    QVERIFY(QDir().mkpath(cpuDir + QLatin1String("/cpufreq")));
+    QVERIFY(QDir().mkpath(cpuDir + QLatin1String("/cpuidle")));
+    QVERIFY(TestPlatform::writeFile(cpuDir + QLatin1String("/online"), "0-7"));
+    qputenv("WAM_SYSFS_ROOT", QFile::encodeName(sysfsDir.path()));
+    TestPlatform::reloadConfig();
+
+    TestWebProcessManager* manager = webProcessManager();
+    manager->readCpuTopology();
+    QVERIFY(manager->m_cpuTopologyRead);
+    QCOMPARE(cpuList(manager->m_bigCpus), bigCpus);
+    QCOMPARE(cpuList(manager->m_littleCpus), littleCpus);
+}
+
+void WebProcessManagerTest::reclaimStages()
+{
+    qputenv("WAM_RECLAIM_STAGE_INTERVAL_IN_MS", "300");
+    qputenv("WAM_RECLAIM_TERMINATE_TIMEOUT_IN_MS", "300");
+    TestPlatform::reloadConfig();
+
+    // The renderer frees one part on the memory pressure notification, one
+    // on SIGTERM and keeps the last until it is killed
+    const int64_t partMemSize = 16 * 1024;
+    int pipeFd = -1;
+    pid_t pid = TestPlatform::forkRenderer(pipeFd, partMemSize, partMemSize, partMemSize);
+    QVERIFY(pid > 0);
+
+    TestWebProcessManager* manager = webProcessManager();
+    for (int i = 0; i < WebProcessManager::ReclaimStageCount; i++)
+        manager->m_reclaimedMemSize[i] = 0;
+
+    FakeWebApp app(QStringLiteral("com.webos.app.reclaim"), pid);
+    manager->watchWebProcess(app.appId(), pid);
+    manager->requestKillWebProcess(pid);
+    QVERIFY(manager->m_reclaimInfoMap.contains(pid));
+    QCOMPARE(app.fakePage()->lastMemoryPressure(), webos::WebViewBase::MEMORY_PRESSURE_CRITICAL);
+    int64_t startMemSize = manager->m_reclaimInfoMap.value(pid).startMemSize;
+    QVERIFY(startMemSize >= 3 * partMemSize);
+
+    char command = 'f';
+    QCOMPARE(write(pipeFd, &command, 1), static_cast<ssize_t>(1));
+
+    // The kill ends the reclaim and the pidfd reports the exit
+    QTRY_VERIFY_WITH_TIMEOUT(!manager->m_reclaimInfoMap.contains(pid), 5000);
+    QTRY_VERIFY_WITH_TIMEOUT(!manager->m_webProcessWatchMap.contains(pid), 5000);
+    close(pipeFd);
+    int status = TestPlatform::waitRenderer(pid);
+    QVERIFY(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+
+    int64_t memoryPressure = manager->m_reclaimedMemSize[WebProcessManager::ReclaimStageMemoryPressure];
+    int64_t pageOut = manager->m_reclaimedMemSize[WebProcessManager::ReclaimStagePageOut];
+    int64_t terminate = manager->m_reclaimedMemSize[WebProcessManager::ReclaimStageTerminate];
+    int64_t kill = manager->m_reclaimedMemSize[WebProcessManager::ReclaimStageKill];
+    qDebug("Recovered KB memoryPressure %lld pageOut %lld terminate %lld kill %lld",
+        static_cast<long long>(memoryPressure), static_cast<long long>(pageOut),
+        static_cast<long long>(terminate), static_cast<long long>(kill));
+
+    // Each stage is credited with what the renderer freed in answer to it.
+    // process_madvise needs a recent kernel and swap to page anything out,
+    // whatever it reclaims is no longer there for the later stages.
+    QVERIFY(qAbs(memoryPressure - partMemSize) < kMemSizeToleranceKB);
+    QVERIFY(terminate < partMemSize + kMemSizeToleranceKB);
+    QVERIFY(terminate + pageOut > partMemSize - kMemSizeToleranceKB);
+    QVERIFY(kill + pageOut > partMemSize - kMemSizeToleranceKB);
+
+    // Every KB is credited to exactly one stage
+    QVERIFY(qAbs(memoryPressure + pageOut + terminate + kill - startMemSize) < kMemSizeToleranceKB);
+}
+
+void WebProcessManagerTest::webProcessExited()
+{
+    int pipeFd = -1;
+    pid_t pid = TestPlatform::forkRenderer(pipeFd);
+    QVERIFY(pid > 0);
+
+    // Two apps sharing the renderer are watched through one pidfd
+    TestWebProcessManager* manager = webProcessManager();
+    manager->m_webProcessInfoMap.insert(QStringLiteral("test"), WebProcessManager::WebProcessInfo(1, pid));
+    FakeWebApp app(QStringLiteral("com.webos.app.exit"), pid);
+    FakeWebApp peer(QStringLiteral("com.webos.app.exit.peer"), pid);
+    manager->watchWebProcess(app.appId(), pid);
+    manager->watchWebProcess(peer.appId(), pid);
+    manager->watchWebProcess(app.appId(), pid);
+    QCOMPARE(manager->m_webProcessWatchMap.size(), 1);
+    QCOMPARE(manager->m_webProcessWatchMap.value(pid).appIds.size(), 2);
+
+    // Closing the pipe lets the renderer exit on its own
+    close(pipeFd);
+    QTRY_VERIFY_WITH_TIMEOUT(!manager->m_webProcessWatchMap.contains(pid), 5000);
+    QCOMPARE(TestPlatform::waitRenderer(pid), 0);
+
+    const WebProcessManager::WebProcessInfo& info = manager->m_webProcessInfoMap.find(QStringLiteral("test")).value();
+    QCOMPARE(info.webProcessPid, 0u);
+    QCOMPARE(info.proxyID, 0u);
+    QCOMPARE(app.fakePage()->exitedPid(), static_cast<uint32_t>(pid));
+    QCOMPARE(peer.fakePage()->exitedPid(), static_cast<uint32_t>(pid));
+}
@@ -23,3 +23,9 @@ wamplugin.file = wamplugin.pri
 wam.file = wam.pri
 
 SUBDIRS += wamcorelib wamlib wamplugin wam
+
+# qmake CONFIG+=tests, then "make check"
+tests {
+    tests.file = tests.pri
+    SUBDIRS += tests
+}
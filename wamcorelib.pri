@@ -19,15 +19,30 @@ TEMPLATE = lib
 include(common.pri)
 
 SOURCES += \
+        AppEvictionManager.cpp \
         ApplicationDescription.cpp \
+        BackgroundCpuBudget.cpp \
+        CgroupManager.cpp \
+        CloseGraceManager.cpp \
         ContainerAppManager.cpp \
+        CrashRecoveryManager.cpp \
         DeviceInfo.cpp \
+        DiskWriteBudget.cpp \
+        ExclusiveModeManager.cpp \
+        IdleTaskScheduler.cpp \
+        KeepAliveTrimmer.cpp \
+        LaunchBoost.cpp \
+        LaunchScheduler.cpp \
         LogManager.cpp \
         LogManagerPmLog.cpp \
+        LowPowerManager.cpp \
         NetworkStatus.cpp \
         NetworkStatusManager.cpp \
         PalmSystemBase.cpp \
         PlugInService.cpp \
+        PreloadAdmission.cpp \
+        PsiMonitor.cpp \
+        SuspendDelayScheduler.cpp \
         Timer.cpp \
         WebAppBase.cpp \
         WebAppFactoryManager.cpp \
@@ -40,19 +55,34 @@ SOURCES += \
         WebProcessManager.cpp
 
 HEADERS += \
+        AppEvictionManager.h \
         ApplicationDescription.h \
+        BackgroundCpuBudget.h \
+        CgroupManager.h \
+        CloseGraceManager.h \
         ContainerAppManager.h \
+        CrashRecoveryManager.h \
         DeviceInfo.h \
+        DiskWriteBudget.h \
+        ExclusiveModeManager.h \
+        IdleTaskScheduler.h \
+        KeepAliveTrimmer.h \
+        LaunchBoost.h \
+        LaunchScheduler.h \
         LogManager.h \
         LogManagerPmLog.h \
         LogMsgId.h \
+        LowPowerManager.h \
         NetworkStatus.h \
         NetworkStatusManager.h \
         ObserverList.h \
         PalmSystemBase.h \
         PlatformModuleFactory.h \
         PlugInService.h \
+        PreloadAdmission.h \
+        PsiMonitor.h \
         ServiceSender.h \
+        SuspendDelayScheduler.h \
         Timer.h \
         WebAppBase.h \
         WebAppFactoryInterface.h \